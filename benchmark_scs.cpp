@@ -0,0 +1,420 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
+#include <unistd.h>
+
+/*
+Benchmark harness for all the engines.
+Each engine is run as its own program (the same binaries the glJob*.sh scripts submit), with
+OMP_NUM_THREADS set for the run (the MPI engine is launched with mpirun -np instead, one rank per
+thread), and the "Execution Time (ms)" and "Length of SCS is" lines are read from its output. For every input file and every thread count, each engine is run a few times
+without timing (warmup) and then repeats times, and the times are summarized as
+median, p10, p90, min and max.
+- speedup = median time of the serial engine on the same input / median time of the engine
+  (if serial is not part of the run, the engine at the lowest thread count is used instead)
+- efficiency = speedup / number of threads
+Every engine must give the same length of SCS for an input (and the engines that find the SCS
+itself must give a supersequence), otherwise the mismatch is reported and the exit code is 1.
+Results are written as CSV or JSON (by the extension of the output file), and a summary table is printed.
+*/
+
+// how to run one engine
+struct Engine {
+    const char *name;
+    const char *program;
+    // engine argument of the program, empty if it has none
+    const char *engine_arg;
+    // whether the program uses OMP_NUM_THREADS, otherwise it is only run once per input
+    bool threaded;
+    // whether the program takes the alphabet (after the engine)
+    bool takes_alphabet;
+    // the only alphabet the engine supports, nullptr if it supports all of them
+    const char *only_alphabet = nullptr;
+    // environment variable set to a new temporary file for every run, nullptr if there is none
+    const char *temp_file_env = nullptr;
+    // whether the program is launched with mpirun, with one rank per thread
+    bool mpi = false;
+};
+
+static const Engine ENGINES[] = {
+    {"serial", "serial_scs", "", false, false},
+    {"anti_diagonal", "parallel_omp_anti_diag_scs", "anti_diagonal", true, false},
+    {"tiled", "parallel_omp_anti_diag_scs", "tiled", true, false},
+    {"optimal", "parallel_omp_scs", "optimal", true, true},
+    {"no_branch", "parallel_omp_scs", "no_branch", true, true},
+    {"linear", "parallel_omp_scs", "linear", true, true},
+    {"pipelined", "parallel_omp_scs", "pipelined", true, true},
+    {"numa", "parallel_omp_scs", "numa", true, true},
+    {"banded", "parallel_omp_scs", "banded", true, true},
+    {"simd", "parallel_omp_scs", "simd", true, true},
+    {"narrow", "parallel_omp_scs", "narrow", true, true},
+    {"bit_parallel", "parallel_omp_scs", "bit_parallel", true, true},
+    {"four_russians", "parallel_omp_scs", "four_russians", true, true, "dna"},
+    {"hirschberg", "parallel_omp_scs", "hirschberg", true, true},
+    {"bit_table", "parallel_omp_scs", "bit_table", true, true},
+    {"checkpoint", "parallel_omp_scs", "checkpoint", true, true, nullptr, "SCS_CHECKPOINT_FILE"},
+    // picks its own engine and team size from the tuning profile (calibrated on its first run)
+    {"auto", "parallel_omp_scs", "auto", false, true},
+    {"cuda", "parallel_cuda_scs", "", false, false},
+    // rows per message = 32 (the default), so that the alphabet can follow
+    {"mpi", "parallel_mpi_scs", "32", true, true, nullptr, nullptr, true},
+};
+
+// options of the harness
+struct Config {
+    std::vector<std::string> engines;
+    std::vector<std::string> inputs = {"input/input-2000.txt", "input/input-4000.txt", "input/input-8000.txt"};
+    std::vector<int> threads;
+    std::string alphabet = "lowercase";
+    std::string bin_dir = ".";
+    // launcher of the MPI engine, e.g. with extra options of the MPI implementation
+    std::string mpirun = "mpirun";
+    std::string output = "benchmark.csv";
+    int warmup = 1;
+    int repeats = 5;
+};
+
+// output of one run of an engine
+struct RunOutput {
+    bool ok = false;
+    double ms = 0;
+    long long length = -1;
+    bool is_supersequence = true;
+    std::string error;
+};
+
+// all runs of one engine on one input with one number of threads
+struct Result {
+    std::string engine;
+    std::string input;
+    int threads;
+    long long length;
+    std::vector<double> times;
+    double median, p10, p90, min, max;
+    double speedup = 0, efficiency = 0;
+};
+
+// EFFECTS: returns the engine with the given name, nullptr if there is none
+const Engine *find_engine(const std::string &name) {
+    for (const Engine &engine : ENGINES) {
+        if (name == engine.name)
+            return &engine;
+    }
+    return nullptr;
+}
+
+// EFFECTS: returns whether engine supports the alphabet of config
+bool supports_alphabet(const Config &config, const Engine &engine) {
+    return engine.only_alphabet == nullptr || config.alphabet == engine.only_alphabet;
+}
+
+// EFFECTS: splits s on commas
+std::vector<std::string> split(const std::string &s) {
+    std::vector<std::string> parts;
+    std::stringstream ss(s);
+    std::string part;
+    while (std::getline(ss, part, ','))
+        if (!part.empty())
+            parts.push_back(part);
+    return parts;
+}
+
+// REQUIRES: sorted is sorted and not empty
+// EFFECTS: returns the p-th percentile (0 <= p <= 100), interpolating between the closest 2 values
+double percentile(const std::vector<double> &sorted, const double p) {
+    const double rank = p / 100.0 * (sorted.size() - 1);
+    const size_t lo = rank;
+    const size_t hi = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (rank - lo) * (sorted[hi] - sorted[lo]);
+}
+
+// EFFECTS: runs engine once on input with the number of threads and parses its output
+RunOutput run_once(const Config &config, const Engine &engine, const std::string &input, const int threads) {
+    RunOutput out;
+    std::string command = "OMP_NUM_THREADS=" + std::to_string(threads) + " ";
+    if (engine.mpi)
+        command = "OMP_NUM_THREADS=1 " + config.mpirun + " -np " + std::to_string(threads) + " ";
+    command += config.bin_dir + "/" + engine.program + " " + input;
+    if (engine.engine_arg[0] != '\0')
+        command += std::string(" ") + engine.engine_arg;
+    if (engine.takes_alphabet)
+        command += " " + config.alphabet;
+    command += " 2>&1";
+    // e.g. the checkpoint engine must not resume from the file of an earlier run
+    std::string temp_file;
+    if (engine.temp_file_env != nullptr) {
+        char path[] = "/tmp/scs_benchmark_XXXXXX";
+        const int fd = mkstemp(path);
+        if (fd < 0) {
+            out.error = "could not create a temporary file";
+            return out;
+        }
+        close(fd);
+        temp_file = path;
+        command = std::string(engine.temp_file_env) + "=" + temp_file + " " + command;
+    }
+    FILE *pipe = popen(command.c_str(), "r");
+    if (pipe == nullptr) {
+        if (!temp_file.empty())
+            remove(temp_file.c_str());
+        out.error = "could not run " + command;
+        return out;
+    }
+    bool has_time = false;
+    char line[4096];
+    std::string last_line;
+    while (fgets(line, sizeof(line), pipe) != nullptr) {
+        // the SCS itself can be longer than the buffer, only its start matters here
+        if (sscanf(line, "Execution Time (ms) %lf", &out.ms) == 1)
+            has_time = true;
+        else if (sscanf(line, "Length of SCS is %lld", &out.length) == 1)
+            continue;
+        else if (strncmp(line, "Is supersequence: false", 23) == 0)
+            out.is_supersequence = false;
+        else if (strncmp(line, "Error", 5) == 0 || strncmp(line, "CUDA Error", 10) == 0)
+            last_line = line;
+    }
+    const int status = pclose(pipe);
+    if (!temp_file.empty())
+        remove(temp_file.c_str());
+    out.ok = status == 0 && has_time && out.length >= 0;
+    if (!out.ok)
+        out.error = command + " failed (exit status " + std::to_string(status) + ") " + last_line;
+    return out;
+}
+
+// MODIFIES: result
+// EFFECTS: computes the statistics of the times of result
+void summarize(Result &result) {
+    std::vector<double> sorted = result.times;
+    std::sort(sorted.begin(), sorted.end());
+    result.median = percentile(sorted, 50);
+    result.p10 = percentile(sorted, 10);
+    result.p90 = percentile(sorted, 90);
+    result.min = sorted.front();
+    result.max = sorted.back();
+}
+
+// MODIFIES: results
+// EFFECTS: fills in speedup and efficiency of every result
+void compute_speedups(std::vector<Result> &results) {
+    // baseline of each input: serial if it was run, otherwise each engine at its lowest thread count
+    std::map<std::string, double> serial_ms;
+    std::map<std::pair<std::string, std::string>, const Result *> lowest;
+    for (const Result &result : results) {
+        if (result.engine == "serial")
+            serial_ms[result.input] = result.median;
+        const Result *&low = lowest[{result.engine, result.input}];
+        if (low == nullptr || result.threads < low->threads)
+            low = &result;
+    }
+    for (Result &result : results) {
+        double baseline;
+        int baseline_threads = 1;
+        if (serial_ms.count(result.input))
+            baseline = serial_ms[result.input];
+        else {
+            baseline = lowest[{result.engine, result.input}]->median;
+            baseline_threads = lowest[{result.engine, result.input}]->threads;
+        }
+        result.speedup = result.median > 0 ? baseline / result.median : 0;
+        result.efficiency = result.speedup * baseline_threads / result.threads;
+    }
+}
+
+// EFFECTS: writes results as CSV
+void write_csv(std::ostream &out, const std::vector<Result> &results) {
+    out << "engine,input,threads,length,runs,median_ms,p10_ms,p90_ms,min_ms,max_ms,speedup,efficiency\n";
+    for (const Result &r : results) {
+        out << r.engine << "," << r.input << "," << r.threads << "," << r.length << "," << r.times.size() << ","
+            << r.median << "," << r.p10 << "," << r.p90 << "," << r.min << "," << r.max << ","
+            << r.speedup << "," << r.efficiency << "\n";
+    }
+}
+
+// EFFECTS: writes results as JSON (an array of objects, with the time of every run)
+void write_json(std::ostream &out, const std::vector<Result> &results) {
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result &r = results[i];
+        out << "  {\"engine\": \"" << r.engine << "\", \"input\": \"" << r.input << "\", \"threads\": " << r.threads
+            << ", \"length\": " << r.length << ", \"median_ms\": " << r.median << ", \"p10_ms\": " << r.p10
+            << ", \"p90_ms\": " << r.p90 << ", \"min_ms\": " << r.min << ", \"max_ms\": " << r.max
+            << ", \"speedup\": " << r.speedup << ", \"efficiency\": " << r.efficiency << ", \"times_ms\": [";
+        for (size_t t = 0; t < r.times.size(); ++t)
+            out << (t ? ", " : "") << r.times[t];
+        out << "]}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+}
+
+// MODIFIES: config
+// EFFECTS: parses the --option value pairs, returns false if one is invalid
+bool parse_args(int argc, char **argv, Config &config) {
+    for (int a = 1; a < argc; a += 2) {
+        const std::string option = argv[a];
+        if (a + 1 >= argc) {
+            printf("Error: Missing value for %s\n", option.c_str());
+            return false;
+        }
+        const std::string value = argv[a + 1];
+        if (option == "--engines")
+            config.engines = split(value);
+        else if (option == "--inputs")
+            config.inputs = split(value);
+        else if (option == "--threads") {
+            config.threads.clear();
+            for (const std::string &t : split(value))
+                config.threads.push_back(atoi(t.c_str()));
+        }
+        else if (option == "--alphabet")
+            config.alphabet = value;
+        else if (option == "--bin-dir")
+            config.bin_dir = value;
+        else if (option == "--mpirun")
+            config.mpirun = value;
+        else if (option == "--out")
+            config.output = value;
+        else if (option == "--warmup")
+            config.warmup = atoi(value.c_str());
+        else if (option == "--repeats")
+            config.repeats = atoi(value.c_str());
+        else {
+            printf("Error: Unknown option %s\n", option.c_str());
+            return false;
+        }
+    }
+    for (const std::string &name : config.engines) {
+        if (find_engine(name) == nullptr) {
+            printf("Error: Unknown engine %s\n", name.c_str());
+            return false;
+        }
+    }
+    for (int threads : config.threads) {
+        if (threads <= 0) {
+            printf("Error: Invalid number of threads provided\n");
+            return false;
+        }
+    }
+    if (config.warmup < 0 || config.repeats <= 0) {
+        printf("Error: Invalid number of warmup runs or repeats provided\n");
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    Config config;
+    if (!parse_args(argc, argv, config)) {
+        printf("Usage: ./<program> [--engines serial,optimal,...(default all)] [--inputs file,...] [--threads 1,2,4,...(default powers of 2 up to the number of cores)] "
+               "[--alphabet lowercase(default) | dna | protein | byte] [--warmup 1(default)] [--repeats 5(default)] [--bin-dir .(default)] [--mpirun mpirun(default)] [--out benchmark.csv(default) | <file>.json]\n");
+        return 1;
+    }
+    // default: every engine whose program is built (e.g. no cuda without nvcc) and that supports the alphabet
+    if (config.engines.empty()) {
+        for (const Engine &engine : ENGINES) {
+            if (access((config.bin_dir + "/" + engine.program).c_str(), X_OK) == 0 && supports_alphabet(config, engine))
+                config.engines.push_back(engine.name);
+        }
+    }
+    if (config.threads.empty()) {
+        const int num_procs = std::max(1u, std::thread::hardware_concurrency());
+        for (int threads = 1; threads < num_procs; threads *= 2)
+            config.threads.push_back(threads);
+        config.threads.push_back(num_procs);
+    }
+    // the optimal, no_branch and serial engines keep the whole tabulation on the stack,
+    // the child processes inherit the limit
+    struct rlimit stack;
+    if (getrlimit(RLIMIT_STACK, &stack) == 0) {
+        stack.rlim_cur = stack.rlim_max;
+        setrlimit(RLIMIT_STACK, &stack);
+    }
+
+    std::vector<Result> results;
+    bool all_match = true;
+    for (const std::string &input : config.inputs) {
+        // length of SCS found by the first engine, every other engine must agree
+        long long expected = -1;
+        std::string expected_engine;
+        for (const std::string &name : config.engines) {
+            const Engine &engine = *find_engine(name);
+            // e.g. four_russians only runs on dna
+            if (!supports_alphabet(config, engine)) {
+                fprintf(stderr, "%s %s N/A (needs --alphabet %s)\n", name.c_str(), input.c_str(), engine.only_alphabet);
+                continue;
+            }
+            for (int threads : config.threads) {
+                // engines without threads only run once per input
+                if (!engine.threaded && threads != config.threads.front())
+                    continue;
+                Result result;
+                result.engine = name;
+                result.input = input;
+                result.threads = engine.threaded ? threads : 1;
+                result.length = -1;
+                bool ok = true;
+                for (int run = 0; run < config.warmup + config.repeats && ok; ++run) {
+                    RunOutput out = run_once(config, engine, input, result.threads);
+                    if (!out.ok) {
+                        fprintf(stderr, "Error: %s\n", out.error.c_str());
+                        ok = false;
+                        break;
+                    }
+                    if (!out.is_supersequence) {
+                        fprintf(stderr, "Error: %s on %s with %d threads did not give a supersequence\n", name.c_str(), input.c_str(), result.threads);
+                        all_match = false;
+                    }
+                    if (run >= config.warmup)
+                        result.times.push_back(out.ms);
+                    result.length = out.length;
+                }
+                if (!ok) {
+                    all_match = false;
+                    continue;
+                }
+                if (expected < 0) {
+                    expected = result.length;
+                    expected_engine = name;
+                }
+                else if (result.length != expected) {
+                    fprintf(stderr, "Error: Length of SCS of %s is %lld with %s but %lld with %s\n", input.c_str(),
+                            result.length, name.c_str(), expected, expected_engine.c_str());
+                    all_match = false;
+                }
+                summarize(result);
+                fprintf(stderr, "%s %s threads=%d median=%f ms\n", name.c_str(), input.c_str(), result.threads, result.median);
+                results.push_back(result);
+            }
+        }
+    }
+    compute_speedups(results);
+
+    // summary table
+    printf("%-14s %-28s %7s %10s %14s %14s %14s %9s %10s\n", "engine", "input", "threads", "length", "median (ms)", "p10 (ms)", "p90 (ms)", "speedup", "efficiency");
+    for (const Result &r : results) {
+        printf("%-14s %-28s %7d %10lld %14.3f %14.3f %14.3f %9.2f %10.2f\n", r.engine.c_str(), r.input.c_str(), r.threads,
+               r.length, r.median, r.p10, r.p90, r.speedup, r.efficiency);
+    }
+    std::ofstream fout(config.output);
+    if (!fout.is_open()) {
+        printf("Error opening file: %s\n", config.output.c_str());
+        return 1;
+    }
+    const bool json = config.output.size() >= 5 && config.output.compare(config.output.size() - 5, 5, ".json") == 0;
+    if (json)
+        write_json(fout, results);
+    else
+        write_csv(fout, results);
+    printf("Results written to %s\n", config.output.c_str());
+    printf("All engines agree: %s\n", all_match ? "true" : "false");
+    return all_match ? 0 : 1;
+}
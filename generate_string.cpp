@@ -1,18 +1,19 @@
 #include <ctime>
 #include <iostream>
 #include <unistd.h>
+#include <vector>
+#include "scs_input.h"
 
-std::string gen_random(const int len) {
+std::string gen_random(const int len, const std::string &alphanum) {
     // static const char alphanum[] =
     //     "0123456789"
     //     "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
     //     "abcdefghijklmnopqrstuvwxyz";
-    static const char alphanum[] = "abcdefghijklmnopqrstuvwxyz";
     std::string tmp_s;
     tmp_s.reserve(len);
 
     for (int i = 0; i < len; ++i) {
-        tmp_s += alphanum[rand() % (sizeof(alphanum) - 1)];
+        tmp_s += alphanum[rand() % alphanum.size()];
     }
 
     return tmp_s;
@@ -21,6 +22,10 @@ std::string gen_random(const int len) {
 int main(int argc, char *argv[]) {
     int length_of_string = 0;
     int num_strings = 1;
+    // symbols to pick from, same as the alphabets in scs_alphabet.h
+    std::string alphanum = "abcdefghijklmnopqrstuvwxyz";
+    // output format, see scs_input.h
+    std::string format = "text";
 
     if (argc == 2) {
         length_of_string = atoi(argv[1]);
@@ -29,7 +34,7 @@ int main(int argc, char *argv[]) {
             return 1;
         }
     }
-    else if (argc == 3) {
+    else if (argc >= 3 && argc <= 5) {
         length_of_string = atoi(argv[1]);
         if (length_of_string <= 0) {
             std::cerr << "Error: Invalid length of string provided." << std::endl;
@@ -40,16 +45,44 @@ int main(int argc, char *argv[]) {
             std::cerr << "Error: Invalid number of strings provided." << std::endl;
             return 1;
         }
+        if (argc >= 4) {
+            std::string alphabet = argv[3];
+            if (alphabet == "dna")
+                alphanum = "ACGT";
+            else if (alphabet == "protein")
+                alphanum = "ACDEFGHIKLMNPQRSTVWY";
+            else if (alphabet != "lowercase") {
+                std::cerr << "Error: Invalid alphabet provided." << std::endl;
+                return 1;
+            }
+        }
+        if (argc == 5) {
+            format = argv[4];
+            if (format != "text" && format != "fasta" && format != "packed") {
+                std::cerr << "Error: Invalid format provided." << std::endl;
+                return 1;
+            }
+        }
     }
     else {
         std::cerr << "Error: Invalid number of arguments provided." << std::endl;
-        std::cerr << "Usage: ./<program name> <length of string> <number of strings = 1(default)>" << std::endl;
+        std::cerr << "Usage: ./<program name> <length of string> <number of strings = 1(default)> <alphabet = lowercase(default) | dna | protein> <format = text(default) | fasta | packed>" << std::endl;
         return 1;
     }
 
     srand((unsigned)time(NULL) * getpid());
+    if (format == "packed") {
+        std::vector<std::string> strings;
+        for (int i = 0; i < num_strings; ++i)
+            strings.push_back(gen_random(length_of_string, alphanum));
+        // 2 bits per char for DNA, otherwise 1 byte
+        write_packed(std::cout, strings, alphanum == "ACGT" ? 2 : 8);
+        return 0;
+    }
     for (int i = 0; i < num_strings; ++i) {
-        std::cout << gen_random(length_of_string) << std::endl;
+        if (format == "fasta")
+            std::cout << ">seq" << i << std::endl;
+        std::cout << gen_random(length_of_string, alphanum) << std::endl;
     }
     return 0;
 }
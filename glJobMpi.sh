@@ -0,0 +1,19 @@
+#!/bin/bash
+# (See https://arc-ts.umich.edu/greatlakes/user-guide/ for command details)
+
+# Set up batch job settings
+#SBATCH --job-name=term_project
+#SBATCH --nodes=2
+#SBATCH --ntasks-per-node=36
+#SBATCH --exclusive
+#SBATCH --time=00:05:00
+#SBATCH --account=eecs587f23_class
+#SBATCH --partition=standard
+
+export NUM_RANKS=$SLURM_NTASKS
+mpirun -np $NUM_RANKS ./parallel_mpi_scs input/input-20000.txt > output-parallel-mpi-scs-20000-$NUM_RANKS.txt
+mpirun -np $NUM_RANKS ./parallel_mpi_scs input/input-40000.txt > output-parallel-mpi-scs-40000-$NUM_RANKS.txt
+mpirun -np $NUM_RANKS ./parallel_mpi_scs input/input-60000.txt > output-parallel-mpi-scs-60000-$NUM_RANKS.txt
+mpirun -np $NUM_RANKS ./parallel_mpi_scs input/input-100000.txt > output-parallel-mpi-scs-100000-$NUM_RANKS.txt
+# edge case: Y is empty, the length of SCS is the length of X (5)
+mpirun -np $NUM_RANKS ./parallel_mpi_scs input/input-empty-y.txt > output-parallel-mpi-scs-empty-y-$NUM_RANKS.txt
@@ -0,0 +1,370 @@
+#include <cstdlib>
+#include "libscs.h"
+#include "parallel_omp_scs.h"
+#include "scs_tune.h"
+
+/*
+Implementation of libscs.h, built into libscs.a.
+The calls use the same kernels as the engines of parallel_omp_scs, with their buffers from the arena:
+- length: the row-wise independent recurrence with 2 rows (linear engine), or for large alphabets
+  (where memo A would be |C| times the size of Y) the Anti-diagonal Algorithm with 3 diagonals,
+  or once tuned, the engine and team size of the tuning profile for the size of the problem
+- supersequence: the full tabulation (optimal engine, or the Anti-diagonal Algorithm for large
+  alphabets) + traceback if it fits in SCS_CONTEXT_TABLE_CELLS cells, Hirschberg otherwise
+- lengths: like parallel_omp_batch_scs, large pairs with all threads, small ones one per thread
+ScsIncremental uses rowwise_independent_cell on its own memo A and frontier.
+*/
+
+// appends of at least this many cells use all threads for each row, smaller ones run serially
+#define SCS_INCREMENTAL_PARALLEL_CELLS (1LL << 20)
+// alphabets with more symbols use the Anti-diagonal Algorithm, which does not need memo A
+#define SCS_CONTEXT_MAX_MEMO_ROWS 64
+// largest tabulation (in cells) supersequence keeps in the arena, 256 MB
+#define SCS_CONTEXT_TABLE_CELLS (1LL << 26)
+// pairs with at least this many cells use all threads for each row (see parallel_omp_batch_scs.cpp)
+#define SCS_CONTEXT_LARGE_CELLS (1LL << 24)
+#define SCS_CONTEXT_ALIGN 64
+
+ScsArena::~ScsArena() {
+    free(buffer);
+}
+
+void ScsArena::reset(const size_t bytes) {
+    used = 0;
+    if (bytes <= size)
+        return;
+    // grow by at least half, so a slowly growing workload does not reallocate on every call
+    free(buffer);
+    size = (MAX(bytes, size + size / 2) + SCS_CONTEXT_ALIGN - 1) / SCS_CONTEXT_ALIGN * SCS_CONTEXT_ALIGN;
+    buffer = (char *)aligned_alloc(SCS_CONTEXT_ALIGN, size);
+    if (buffer == nullptr) {
+        printf("Error: Could not allocate %zu bytes\n", size);
+        exit(1);
+    }
+}
+
+int *ScsArena::take(const size_t count) {
+    int *block = (int *)(buffer + used);
+    used += bytes_for(count);
+    return block;
+}
+
+size_t ScsArena::bytes_for(const size_t count) {
+    return (count * sizeof(int) + SCS_CONTEXT_ALIGN - 1) / SCS_CONTEXT_ALIGN * SCS_CONTEXT_ALIGN;
+}
+
+template <typename Alphabet>
+ScsContext<Alphabet>::ScsContext(const int num_threads) {
+    team_size = (num_threads > 0) ? num_threads : omp_get_num_procs();
+    // start the threads now, the runtime keeps them for the next regions
+#pragma omp parallel num_threads(team_size)
+    { }
+}
+
+template <typename Alphabet>
+ScsContext<Alphabet>::~ScsContext() = default;
+
+template <typename Alphabet>
+void ScsContext<Alphabet>::tune(const std::string &profile_path) {
+    // only the team sizes this context can use
+    tuner = std::make_unique<ScsTuner<Alphabet>>(team_size);
+    tuner->load_or_calibrate(profile_path);
+}
+
+template <typename Alphabet>
+int ScsContext<Alphabet>::length(std::string_view X, std::string_view Y) {
+    const size_t n = X.size();
+    const size_t m = Y.size();
+    if (tuner != nullptr) {
+        const TuneChoice &choice = tuner->choose(n, m);
+        arena.reset(ScsArena::bytes_for(tune_buffer_ints<Alphabet>(choice.engine, n, m)));
+        return run_tuned<Alphabet>(choice, X, Y, arena.take(tune_buffer_ints<Alphabet>(choice.engine, n, m)));
+    }
+    if (Alphabet::SIZE > SCS_CONTEXT_MAX_MEMO_ROWS) {
+        arena.reset(ScsArena::bytes_for(3 * (n+1)));
+        return scs_anti_diagonal_rolling<Alphabet>(X, Y, arena.take(3 * (n+1)), team_size);
+    }
+    arena.reset(ScsArena::bytes_for(Alphabet::SIZE * (m+1)) + 2 * ScsArena::bytes_for(m+1));
+    int *A = arena.take(Alphabet::SIZE * (m+1));
+    int *prev = arena.take(m+1);
+    int *curr = arena.take(m+1);
+    return scs_rowwise_independent_linear<Alphabet>(X, Y, A, prev, curr, team_size);
+}
+
+template <typename Alphabet>
+std::string ScsContext<Alphabet>::supersequence(std::string_view X, std::string_view Y) {
+    const int n = X.size();
+    const int m = Y.size();
+    if ((long long)(n+1) * (m+1) > SCS_CONTEXT_TABLE_CELLS)
+        return find_scs_hirschberg<Alphabet>(X, Y, team_size);
+    const bool use_memo = Alphabet::SIZE <= SCS_CONTEXT_MAX_MEMO_ROWS;
+    const size_t memo_ints = use_memo ? (size_t)Alphabet::SIZE * (m+1) : 0;
+    arena.reset(ScsArena::bytes_for(memo_ints) + ScsArena::bytes_for((size_t)(n+1) * (m+1)));
+    int *A = arena.take(memo_ints);
+    // tab[i][j] = tab[i * (m+1) + j]
+    int *tab = arena.take((size_t)(n+1) * (m+1));
+    if (use_memo) {
+        // Row-wise Independent Algorithm, same as the optimal engine
+        compute_j_minus_k<Alphabet>(Y, A);
+#pragma omp parallel num_threads(team_size)
+{
+#pragma omp for schedule(static)
+        for (int j = 0; j <= m; ++j)
+            tab[j] = j;
+        // every thread goes through all rows, the implicit barrier of omp for ends each row
+        for (int i = 1; i <= n; ++i) {
+            const int *A_c = &A[(size_t)symbol_idx<Alphabet>(X, i-1) * (m+1)];
+            const int *prev = &tab[(size_t)(i-1) * (m+1)];
+            int *curr = &tab[(size_t)i * (m+1)];
+            curr[0] = i;
+#pragma omp for schedule(static)
+            for (int j = 1; j <= m; ++j)
+                curr[j] = rowwise_independent_cell(A_c, prev, i, j);
+        }
+}
+    }
+    else {
+        // Anti-diagonal Algorithm, same as parallel_omp_anti_diag_scs
+#pragma omp parallel num_threads(team_size)
+{
+        for (int d = 0; d <= n + m; ++d) {
+#pragma omp for schedule(static)
+            for (int a = MAX(0, d - m); a <= MIN(n, d); ++a) {
+                const int b = d - a;
+                int *cell = &tab[(size_t)a * (m+1) + b];
+                if (a == 0)
+                    *cell = b;
+                else if (b == 0)
+                    *cell = a;
+                else if (X[a - 1] == Y[b - 1])
+                    *cell = 1 + cell[-(m+1) - 1];
+                else
+                    *cell = 1 + MIN(cell[-1], cell[-(m+1)]);
+            }
+        }
+}
+    }
+    // traceback, same as SCS_bottom_up in serial_scs.cpp
+    const int length = tab[(size_t)n * (m+1) + m];
+    std::string scs(length, ' ');
+    int idx_to_write = length - 1;
+    int i = n, j = m;
+    while (i > 0 && j > 0) {
+        if (X[i-1] == Y[j-1]) {
+            scs[idx_to_write--] = X[i-1];
+            --i;
+            --j;
+        }
+        else if (tab[(size_t)i * (m+1) + j-1] < tab[(size_t)(i-1) * (m+1) + j]) {
+            scs[idx_to_write--] = Y[j-1];
+            --j;
+        }
+        else {
+            scs[idx_to_write--] = X[i-1];
+            --i;
+        }
+    }
+    while (j > 0) {
+        scs[idx_to_write--] = Y[j-1];
+        --j;
+    }
+    while (i > 0) {
+        scs[idx_to_write--] = X[i-1];
+        --i;
+    }
+    return scs;
+}
+
+template <typename Alphabet>
+std::vector<int> ScsContext<Alphabet>::lengths(const std::vector<std::pair<std::string_view, std::string_view>> &pairs) {
+    const int num_pairs = pairs.size();
+    std::vector<int> results(num_pairs);
+    // Step 1: large pairs, one at a time with all threads
+    std::vector<int> small;
+    size_t max_m = 0;
+    for (int p = 0; p < num_pairs; ++p) {
+        if ((long long)pairs[p].first.size() * pairs[p].second.size() >= SCS_CONTEXT_LARGE_CELLS)
+            results[p] = length(pairs[p].first, pairs[p].second);
+        else {
+            small.push_back(p);
+            max_m = MAX(max_m, pairs[p].second.size());
+        }
+    }
+    if (small.empty())
+        return results;
+    // Step 2: small pairs, one per thread, each thread with its own memo A and 2 rows from the arena
+    const size_t memo_ints = (size_t)Alphabet::SIZE * (max_m+1);
+    const size_t thread_bytes = ScsArena::bytes_for(memo_ints) + 2 * ScsArena::bytes_for(max_m+1);
+    arena.reset(team_size * thread_bytes);
+    std::vector<int *> buffers(3 * team_size);
+    for (int t = 0; t < team_size; ++t) {
+        buffers[3 * t] = arena.take(memo_ints);
+        buffers[3 * t + 1] = arena.take(max_m+1);
+        buffers[3 * t + 2] = arena.take(max_m+1);
+    }
+    const int num_small = small.size();
+#pragma omp parallel num_threads(team_size)
+{
+    const int tid = omp_get_thread_num();
+#pragma omp for schedule(dynamic)
+    for (int s = 0; s < num_small; ++s) {
+        const int p = small[s];
+        results[p] = scs_rowwise_independent_serial<Alphabet>(pairs[p].first, pairs[p].second,
+                                                              buffers[3 * tid], buffers[3 * tid + 1], buffers[3 * tid + 2]);
+    }
+}
+    return results;
+}
+
+// REQUIRES: prev holds cols m to m+q of row i-1 (local col 0 is col m), A_c is the row of memo A
+//           for the char X[i-1], left = tab[i][m], 1 <= q
+// EFFECTS: returns tab[i][m+q] using the row-wise independent recurrence
+static inline int appended_col_cell(const int *A_c, const int *prev, const int left, const int m, const int q) {
+    const int j = m + q;
+    const int p = A_c[j];
+    // last occurrence in the new cols, or tab[i][j-1] goes up by 1 per col from tab[i][m]
+    const int tab_i_j_minus_1 = (p > m) ? prev[p - m - 1] + (j - p) : left + q - 1;
+    return 1 + MIN(tab_i_j_minus_1, prev[q]);
+}
+
+template <typename Alphabet>
+ScsIncremental<Alphabet>::ScsIncremental(const int num_threads) {
+    team_size = (num_threads > 0) ? num_threads : omp_get_num_procs();
+    // tab[0][0] = 0
+    row.assign(1, 0);
+    col.assign(1, 0);
+}
+
+template <typename Alphabet>
+int ScsIncremental<Alphabet>::append_x(std::string_view chars) {
+    const int k = chars.size();
+    const int m = Y.size();
+    const int first = X.size() + 1;
+    if (k == 0)
+        return length();
+    X.append(chars);
+    if (m == 0) {
+        // Y is empty (and so is memo A), every row is just tab[i][0] = i
+        for (int i = first; i < first + k; ++i)
+            col.push_back(i);
+        row.assign(1, first + k - 1);
+        return length();
+    }
+    prev_row.swap(row);
+    curr_row.resize(m+1);
+    int *prev = prev_row.data();
+    int *curr = curr_row.data();
+    if ((long long)k * m < SCS_INCREMENTAL_PARALLEL_CELLS) {
+        // small append (e.g. 1 char), no team: the barriers per row would cost more than the row
+        for (int i = first; i < first + k; ++i) {
+            const int *A_c = A.data() + (size_t)symbol_idx<Alphabet>(X, i-1) * stride;
+            curr[0] = i;
+            for (int j = 1; j <= m; ++j)
+                curr[j] = rowwise_independent_cell(A_c, prev, i, j);
+            col.push_back(curr[m]);
+            std::swap(prev, curr);
+        }
+    }
+    else {
+        // rows first to first+k-1, same as the linear engine
+#pragma omp parallel num_threads(team_size)
+{
+        for (int i = first; i < first + k; ++i) {
+            const int *A_c = A.data() + (size_t)symbol_idx<Alphabet>(X, i-1) * stride;
+#pragma omp for schedule(static)
+            for (int j = 1; j <= m; ++j)
+                curr[j] = rowwise_independent_cell(A_c, prev, i, j);
+#pragma omp single
+{
+            curr[0] = i;
+            col.push_back(curr[m]);
+            std::swap(prev, curr);
+}
+        }
+}
+    }
+    // row first+k-1 is in prev
+    row.assign(prev, prev + m + 1);
+    return length();
+}
+
+template <typename Alphabet>
+int ScsIncremental<Alphabet>::append_y(std::string_view chars) {
+    const int k = chars.size();
+    const int n = X.size();
+    const int m = Y.size();
+    if (k == 0)
+        return length();
+    Y.append(chars);
+    // Step 1: extend memo A by k cols, growing every row (at least doubling) if they do not fit
+    if ((size_t)m + k + 1 > stride) {
+        const size_t new_stride = MAX((size_t)m + k + 1, 2 * stride);
+        std::vector<int> grown((size_t)Alphabet::SIZE * new_stride);
+        for (int c = 0; c < Alphabet::SIZE; ++c) {
+            if (stride > 0)
+                std::copy(A.data() + (size_t)c * stride, A.data() + (size_t)c * stride + m + 1, grown.data() + (size_t)c * new_stride);
+            else
+                grown[(size_t)c * new_stride] = 0;
+        }
+        A.swap(grown);
+        stride = new_stride;
+    }
+    for (int c = 0; c < Alphabet::SIZE; ++c) {
+        int *A_c = A.data() + (size_t)c * stride;
+        for (int j = m + 1; j <= m + k; ++j)
+            A_c[j] = (symbol_idx<Alphabet>(Y, j-1) == c) ? j : A_c[j-1];
+    }
+    // Step 2: cols m+1 to m+k of every row, local col q is col m+q, local col 0 is the old last col
+    prev_row.resize(k+1);
+    curr_row.resize(k+1);
+    int *prev = prev_row.data();
+    int *curr = curr_row.data();
+    // row 0
+    for (int q = 0; q <= k; ++q)
+        prev[q] = m + q;
+    next_col.resize(n+1);
+    next_col[0] = m + k;
+    if ((long long)n * k < SCS_INCREMENTAL_PARALLEL_CELLS) {
+        // small append (e.g. 1 char), no team
+        for (int i = 1; i <= n; ++i) {
+            const int *A_c = A.data() + (size_t)symbol_idx<Alphabet>(X, i-1) * stride;
+            curr[0] = col[i];
+            for (int q = 1; q <= k; ++q)
+                curr[q] = appended_col_cell(A_c, prev, curr[0], m, q);
+            next_col[i] = curr[k];
+            std::swap(prev, curr);
+        }
+    }
+    else {
+#pragma omp parallel num_threads(team_size)
+{
+        for (int i = 1; i <= n; ++i) {
+            const int *A_c = A.data() + (size_t)symbol_idx<Alphabet>(X, i-1) * stride;
+            // tab[i][m]
+            const int left = col[i];
+#pragma omp for schedule(static)
+            for (int q = 1; q <= k; ++q)
+                curr[q] = appended_col_cell(A_c, prev, left, m, q);
+#pragma omp single
+{
+            curr[0] = left;
+            next_col[i] = curr[k];
+            std::swap(prev, curr);
+}
+        }
+}
+    }
+    // row n is in prev
+    row.insert(row.end(), prev + 1, prev + k + 1);
+    col.swap(next_col);
+    return length();
+}
+
+template class ScsContext<LowercaseAlphabet>;
+template class ScsContext<DnaAlphabet>;
+template class ScsContext<ProteinAlphabet>;
+template class ScsContext<ByteAlphabet>;
+template class ScsIncremental<LowercaseAlphabet>;
+template class ScsIncremental<DnaAlphabet>;
+template class ScsIncremental<ProteinAlphabet>;
+template class ScsIncremental<ByteAlphabet>;
@@ -0,0 +1,178 @@
+#ifndef LIBSCS_H
+#define LIBSCS_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "scs_alphabet.h"
+
+/*
+Library API (libscs.a, see libscs.cpp) for calling SCS many times from one process, e.g. a service.
+Calling the engines of parallel_omp_scs directly allocates memo A and tab on every call (and
+page faults on them the first time they are touched), and the team of threads may be created again.
+A ScsContext instead keeps
+- an arena: one buffer that memo A, the rows and the tabulation of every call are carved out of.
+  It only ever grows (to the largest problem seen so far), so after the first few calls there are
+  no allocations or page faults at all.
+- a warm team: the OpenMP threads are started when the context is created and every call uses
+  the same number of threads, so the runtime reuses them instead of creating threads per call.
+  The team size is given to each parallel region, the number of threads of the caller is left alone.
+The strings are used in place (no copy or packing), and must only contain chars of Alphabet.
+A context is not thread-safe, use one context per calling thread.
+
+    ScsContext<DnaAlphabet> context;
+    int length = context.length("ACGT", "GTCA");
+    std::string scs = context.supersequence("ACGT", "GTCA");
+
+With tune, length picks the engine and team size per call from a tuning profile (see scs_tune.h)
+instead of always using the row-wise kernel with all threads of the team.
+*/
+
+template <typename Alphabet>
+class ScsTuner;
+
+// buffer that hands out blocks of memory, reused across calls
+class ScsArena {
+public:
+    ScsArena() = default;
+    ScsArena(const ScsArena &) = delete;
+    ScsArena &operator=(const ScsArena &) = delete;
+    ~ScsArena();
+
+    // MODIFIES: this
+    // EFFECTS: makes sure there are at least bytes bytes, and hands out blocks from the start again,
+    //          i.e. invalidates all blocks handed out before
+    void reset(size_t bytes);
+
+    // REQUIRES: the blocks taken since the last reset fit in the bytes given to it
+    // MODIFIES: this
+    // EFFECTS: returns a block of count ints, aligned to a cache line
+    int *take(size_t count);
+
+    // EFFECTS: returns the number of bytes needed for count ints (with alignment)
+    static size_t bytes_for(size_t count);
+
+    // EFFECTS: returns the size of the buffer
+    size_t capacity() const {
+        return size;
+    }
+
+private:
+    char *buffer = nullptr;
+    size_t size = 0;
+    size_t used = 0;
+};
+
+template <typename Alphabet>
+class ScsContext {
+public:
+    // EFFECTS: starts the team of num_threads threads (all cores if 0)
+    explicit ScsContext(int num_threads = 0);
+    ~ScsContext();
+
+    // MODIFIES: this
+    // EFFECTS: loads the tuning profile at path (calibrating and saving it first if it has no
+    //          choices for Alphabet and num_threads() on this machine, calibrating team sizes of
+    //          at most num_threads() threads), after which length uses the engine and team size of
+    //          the profile
+    void tune(const std::string &profile_path);
+
+    // REQUIRES: X, Y only contain chars in Alphabet
+    // EFFECTS: returns the length of SCS of X and Y
+    int length(std::string_view X, std::string_view Y);
+
+    // REQUIRES: X, Y only contain chars in Alphabet
+    // EFFECTS: returns an SCS of X and Y
+    std::string supersequence(std::string_view X, std::string_view Y);
+
+    // REQUIRES: all strings only contain chars in Alphabet
+    // EFFECTS: returns the length of SCS of each pair, large pairs use all threads for each pair,
+    //          small pairs run one per thread
+    std::vector<int> lengths(const std::vector<std::pair<std::string_view, std::string_view>> &pairs);
+
+    // EFFECTS: returns the number of threads used by every call
+    int num_threads() const {
+        return team_size;
+    }
+
+    // EFFECTS: returns the number of bytes held by the arena
+    size_t arena_bytes() const {
+        return arena.capacity();
+    }
+
+private:
+    int team_size;
+    ScsArena arena;
+    // null until tune is called
+    std::unique_ptr<ScsTuner<Alphabet>> tuner;
+};
+
+/*
+Incremental SCS of 2 strings that grow over time, without starting over from tab[0][0].
+Only the frontier of tab is kept: its last row tab[n][0..m] and last col tab[0..n][m] (plus memo A).
+- appending k chars to X is k more rows of the row-wise independent recurrence, O(k * m)
+- appending k chars to Y extends memo A by k cols, and computes the new cols tab[0..n][m+1..m+k] as
+  rows of width k: within row i, tab[i][j-1] for the cols since the last occurrence p of X[i-1] goes
+  up by 1 per col, so if p is not one of the new cols, tab[i][j-1] = tab[i][m] + (j-1-m), i.e. the
+  last col is all that is needed of the old cols. O(k * n)
+Large appends use all threads for each row (like the linear engine), small ones (e.g. 1 char) run on
+the calling thread. Memo A has one row per symbol, so use it with small alphabets.
+
+    ScsIncremental<DnaAlphabet> scs;
+    scs.append_x("ACGT");
+    int length = scs.append_y("GTCA");
+*/
+template <typename Alphabet>
+class ScsIncremental {
+public:
+    // EFFECTS: starts with X and Y empty, large appends use num_threads threads (all cores if 0)
+    explicit ScsIncremental(int num_threads = 0);
+
+    // REQUIRES: chars only contains chars in Alphabet
+    // MODIFIES: this
+    // EFFECTS: appends chars to X, returns the new length of SCS
+    int append_x(std::string_view chars);
+
+    // REQUIRES: chars only contains chars in Alphabet
+    // MODIFIES: this
+    // EFFECTS: appends chars to Y, returns the new length of SCS
+    int append_y(std::string_view chars);
+
+    // EFFECTS: returns the length of SCS of X and Y so far
+    int length() const {
+        return row.back();
+    }
+
+    // EFFECTS: returns X and Y so far
+    const std::string &x() const {
+        return X;
+    }
+    const std::string &y() const {
+        return Y;
+    }
+
+private:
+    int team_size;
+    std::string X, Y;
+    // A[c][j] = A[c * stride + j], stride >= m+1 so cols can be appended in place
+    std::vector<int> A;
+    size_t stride = 0;
+    // tab[n][0..m] and tab[0..n][m]
+    std::vector<int> row, col;
+    // rows and last col while appending
+    std::vector<int> prev_row, curr_row, next_col;
+};
+
+extern template class ScsContext<LowercaseAlphabet>;
+extern template class ScsContext<DnaAlphabet>;
+extern template class ScsContext<ProteinAlphabet>;
+extern template class ScsContext<ByteAlphabet>;
+extern template class ScsIncremental<LowercaseAlphabet>;
+extern template class ScsIncremental<DnaAlphabet>;
+extern template class ScsIncremental<ProteinAlphabet>;
+extern template class ScsIncremental<ByteAlphabet>;
+
+#endif
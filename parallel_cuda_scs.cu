@@ -1,6 +1,6 @@
 /* Author: zhaojer */
 #include <string>
-#include <fstream>
+#include "scs_input.h"
 
 #define ALPHABET_SIZE 26
 #define CONVERT_LETTER_TO_IDX(letter) (int(letter) - 97)
@@ -156,20 +156,12 @@ int main(int argc, char** argv)
         return 1;
     }
     printf("Input: %s\n", input_file.c_str());
-    // 2 input strings
-    std::string X = "ozpxennwaelglzwocdybdmpmmcyconwcmlbsaoqcvciidewfiuiljaavcazqnvvbjyvjpmokqwstboa";
-    std::string Y = "iyklqkkdhnvwnrjbxkuyltiaqbllgsipqvaihmlozhnmyypxkjwwegyujjhqepfumhfuvqiuzvixtxxgivcobakllrbriimvrrpmjzgjxqisnfy";
-    // read input string from file
-    std::ifstream fin;
-    fin.open(input_file);
-    // throw error if the file opening fails
-    if (!fin.is_open()) {
-        printf("Error opening file: %s\n", input_file.c_str());
+    // read the 2 input strings from file (views into the mapped file)
+    ScsInput input;
+    if (!load_pair_input(input_file, input))
         return 1;
-    }
-    std::getline(fin, X);
-    std::getline(fin, Y);
-    fin.close();
+    const std::string_view X = input.records[0];
+    const std::string_view Y = input.records[1];
 
     // size of strings
     const long long n = X.size();
@@ -199,11 +191,14 @@ int main(int argc, char** argv)
     }
 
     // copy memory to device
-    if (cudaMemcpy(d_X, X.c_str(), sizeof(char) * (n+1), cudaMemcpyHostToDevice) != cudaSuccess) {
+    // straight from the mapped file, the views are not null terminated
+    if (cudaMemcpy(d_X, X.data(), sizeof(char) * n, cudaMemcpyHostToDevice) != cudaSuccess ||
+        cudaMemset(d_X + n, 0, sizeof(char)) != cudaSuccess) {
         printf("CUDA Error: Could not copy X into d_X\n");
         return 1;
     }
-    if (cudaMemcpy(d_Y, Y.c_str(), sizeof(char) * (m+1), cudaMemcpyHostToDevice) != cudaSuccess) {
+    if (cudaMemcpy(d_Y, Y.data(), sizeof(char) * m, cudaMemcpyHostToDevice) != cudaSuccess ||
+        cudaMemset(d_Y + m, 0, sizeof(char)) != cudaSuccess) {
         printf("CUDA Error: Could not copy Y into d_Y\n");
         return 1;
     }
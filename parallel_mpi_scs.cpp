@@ -0,0 +1,231 @@
+#include <mpi.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "scs_alphabet.h"
+#include "scs_input.h"
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+/*
+Distributed Row-wise Independent Algorithm (MPI).
+All the other engines need the whole problem (at least memo A and a row of tab) in one address
+space or on one GPU. Here string Y is split into column bands, one per rank, and each rank only
+holds memo A and the rows of tab for its own band, so the memory per rank is O(|C| * m / ranks).
+(X is needed by every rank, but only n chars.)
+
+Rank r owns cols [lo, hi] of tab. Its cells of row i only read row i-1 (see parallel_omp_scs.h):
+    tab[i][j] = 1 + MIN(tab[i-1][j-k-1] + k, tab[i-1][j])    with j-k = A[c][j], c = X[i-1]
+tab[i-1][j] is in the band, and so is tab[i-1][j-k-1] if Y[lo-1, j) contains c. Otherwise j-k is the
+last occurrence p of c before the band (or 0 if there is none), no matter which col j it is for, so
+    tab[i-1][j-k-1] + k = (tab[i-1][p-1] - p) + j
+i.e. for each letter c, the rank only needs the single value S[c] = tab[i-1][p-1] - p of the bands to its
+left (and S[c] = tab[i-1][0] = i-1 if there is no p). The rank to the left can compute S for the
+next rank from its own S and band: for the letters that occur in its band, p is the last occurrence
+in the band, otherwise S stays the same. Together with tab[i-1][lo-1] (the col just left of the band,
+for when p = lo), this summary of |C|+1 ints per row is all that is ever sent, instead of a row.
+
+Thus ranks form a pipeline: rank r computes row i once it has the summary of row i-1 from rank r-1,
+and sends the summary of row i-1 of everything up to its own band to rank r+1.
+To hide the latency, the summaries of a block of rows are sent in one message (without waiting for it
+to be received), and the message of the next block is already being received while computing a block.
+Larger blocks mean fewer messages, but rank r can only start once rank r-1 has finished its first
+block, so the pipeline takes (ranks - 1) * rows per message rows to fill up.
+The last rank ends up with tab[n][m], i.e. the length of the SCS.
+*/
+
+// EFFECTS: returns the band of cols [lo, hi] of rank out of cols 1 to m, empty (hi = lo-1) if m < ranks
+static void column_band(const int m, const int rank, const int num_ranks, int &lo, int &hi) {
+    lo = (long long)m * rank / num_ranks + 1;
+    hi = (long long)m * (rank + 1) / num_ranks;
+}
+
+// REQUIRES: called by every rank, X, Y only contain chars in Alphabet, rows_per_message > 0
+// EFFECTS: returns the length of SCS on the last rank (-1 on the other ranks)
+template <typename Alphabet>
+int scs_rowwise_independent_mpi(std::string_view X_text, std::string_view Y_text, const int rows_per_message) {
+    int rank, num_ranks;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+    const int n = X_text.size();
+    const int m = Y_text.size();
+    int lo, hi;
+    column_band(m, rank, num_ranks, lo, hi);
+    // width of the band, local col k is col lo-1+k, i.e. col 0 is the col just left of the band
+    const int w = hi - lo + 1;
+    // each rank only packs its own slice of Y
+    const PackedString<Alphabet> X(X_text), Y(Y_text.substr(lo - 1, w));
+    // memo A of the band and 2 rows (+1 col left of the band), allocated upfront
+    std::vector<int> A((size_t)Alphabet::SIZE * (w+1));
+    std::vector<int> prev_row(w+1), curr_row(w+1);
+    int *prev = prev_row.data();
+    int *curr = curr_row.data();
+    // summary (S[0..|C|-1], tab[i][hi]) of each row of a block, 2 blocks each so one can be in flight
+    const int summary_ints = Alphabet::SIZE + 1;
+    std::vector<int> recv_buf[2], send_buf[2];
+    for (int b = 0; b < 2; ++b) {
+        recv_buf[b].resize((size_t)rows_per_message * summary_ints);
+        send_buf[b].resize((size_t)rows_per_message * summary_ints);
+    }
+    MPI_Request recv_req[2] = {MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+    MPI_Request send_req[2] = {MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+    const bool has_left = rank > 0;
+    const bool has_right = rank < num_ranks - 1;
+    // summaries are sent for rows 0 to n-1, in blocks of rows_per_message rows
+    const int num_blocks = (n + rows_per_message - 1) / rows_per_message;
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    double start, end;
+    // record start time
+    start = MPI_Wtime();
+    // Step 1: fill out j-k values of the band, 0 if the letter does not occur in the band up to col j
+    for (int c = 0; c < Alphabet::SIZE; ++c) {
+        int *A_c = &A[(size_t)c * (w+1)];
+        A_c[0] = 0;
+        for (int k = 1; k <= w; ++k)
+            A_c[k] = (Y.idx(k-1) == c) ? k : A_c[k-1];
+    }
+    // base case (row 0)
+    for (int k = 0; k <= w; ++k)
+        prev[k] = lo - 1 + k;
+    if (has_left && num_blocks > 0)
+        MPI_Irecv(recv_buf[0].data(), MIN(rows_per_message, n) * summary_ints, MPI_INT, rank - 1, 0, MPI_COMM_WORLD, &recv_req[0]);
+
+    // Step 2: go through the rows block by block
+    for (int b = 0; b < num_blocks; ++b) {
+        const int first = b * rows_per_message;
+        const int last = MIN(first + rows_per_message, n);
+        int *in = recv_buf[b % 2].data();
+        int *out = send_buf[b % 2].data();
+        if (has_left) {
+            // summaries of this block, then start receiving the next one
+            MPI_Wait(&recv_req[b % 2], MPI_STATUS_IGNORE);
+            if (b + 1 < num_blocks) {
+                const int next_rows = MIN(last + rows_per_message, n) - last;
+                MPI_Irecv(recv_buf[(b+1) % 2].data(), next_rows * summary_ints, MPI_INT, rank - 1, 0, MPI_COMM_WORLD, &recv_req[(b+1) % 2]);
+            }
+        }
+        else {
+            // nothing to the left of col 1 but col 0, i.e. tab[i][0] = i
+            for (int i = first; i < last; ++i)
+                std::fill(&in[(size_t)(i - first) * summary_ints], &in[(size_t)(i - first + 1) * summary_ints], i);
+        }
+        // the send buffer of 2 blocks ago must be free again
+        if (has_right)
+            MPI_Wait(&send_req[b % 2], MPI_STATUS_IGNORE);
+        // prev holds row i, compute row i+1
+        for (int i = first; i < last; ++i) {
+            const int *S = &in[(size_t)(i - first) * summary_ints];
+            // col lo-1 of row i
+            prev[0] = S[Alphabet::SIZE];
+            if (has_right) {
+                // summary of row i up to col hi for the next rank
+                int *S_out = &out[(size_t)(i - first) * summary_ints];
+                for (int c = 0; c < Alphabet::SIZE; ++c) {
+                    const int p = A[(size_t)c * (w+1) + w];
+                    S_out[c] = (p > 0) ? prev[p-1] - (lo - 1 + p) : S[c];
+                }
+                S_out[Alphabet::SIZE] = prev[w];
+                // opt: send the block as soon as it is ready, before computing the last row of it
+                if (i == last - 1)
+                    MPI_Isend(out, (last - first) * summary_ints, MPI_INT, rank + 1, 0, MPI_COMM_WORLD, &send_req[b % 2]);
+            }
+            const int c = X.idx(i);
+            const int *A_c = &A[(size_t)c * (w+1)];
+            // tab[i][j-k-1] + k of the cols without c in the band before them
+            const int outside = S[c] + (lo - 1);
+            for (int k = 1; k <= w; ++k) {
+                const int j_minus_k = A_c[k];
+                const int tab_i_j_minus_1 = (j_minus_k > 0) ? prev[j_minus_k-1] + (k - j_minus_k) : outside + k;
+                curr[k] = 1 + MIN(tab_i_j_minus_1, prev[k]);
+            }
+            std::swap(prev, curr);
+        }
+    }
+    MPI_Waitall(2, send_req, MPI_STATUSES_IGNORE);
+    // record end time (of the slowest rank)
+    end = MPI_Wtime();
+    double ms = (end - start) * 1000.0, max_ms;
+    MPI_Reduce(&ms, &max_ms, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    if (rank == 0)
+        printf("Execution Time (ms) %f\n", max_ms);
+    // row n is in prev, col m is on the last rank. If Y is empty the band of the last rank is empty
+    // too, and prev[0] is only its ghost col of row n-1 (no summary is sent for row n), so
+    // tab[n][0] = n is returned directly
+    if (has_right)
+        return -1;
+    return (m == 0) ? n : prev[w];
+}
+
+// EFFECTS: runs the engine with the alphabet of the given name on every rank, returns the length of
+//          SCS on the last rank, -1 on the other ranks and -2 if the alphabet is unknown or the
+//          strings have chars outside of it
+int run_mpi(const std::string &alphabet, std::string_view X, std::string_view Y, const int rows_per_message) {
+    if (alphabet == LowercaseAlphabet::NAME && LowercaseAlphabet::valid(X) && LowercaseAlphabet::valid(Y))
+        return scs_rowwise_independent_mpi<LowercaseAlphabet>(X, Y, rows_per_message);
+    if (alphabet == DnaAlphabet::NAME && DnaAlphabet::valid(X) && DnaAlphabet::valid(Y))
+        return scs_rowwise_independent_mpi<DnaAlphabet>(X, Y, rows_per_message);
+    if (alphabet == ProteinAlphabet::NAME && ProteinAlphabet::valid(X) && ProteinAlphabet::valid(Y))
+        return scs_rowwise_independent_mpi<ProteinAlphabet>(X, Y, rows_per_message);
+    if (alphabet == ByteAlphabet::NAME)
+        return scs_rowwise_independent_mpi<ByteAlphabet>(X, Y, rows_per_message);
+    return -2;
+}
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+    int rank, num_ranks;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+    // get input file name (and rows per message, alphabet) from commandline if one is provided
+    std::string input_file = "input/input-2000.txt";
+    int rows_per_message = 32;
+    std::string alphabet = LowercaseAlphabet::NAME;
+    if (argc > 4 || (argc >= 3 && atoi(argv[2]) <= 0)) {
+        if (rank == 0) {
+            printf("Error: Invalid arguments provided\n");
+            printf("Usage: mpirun -np <ranks> ./parallel_mpi_scs <input file> <rows per message = 32(default)> <alphabet = lowercase(default) | dna | protein | byte>\n");
+        }
+        MPI_Finalize();
+        return 1;
+    }
+    if (argc >= 2)
+        input_file = argv[1];
+    if (argc >= 3)
+        rows_per_message = atoi(argv[2]);
+    if (argc == 4)
+        alphabet = argv[3];
+    // every rank maps the input, but only touches X and its own band of Y
+    ScsInput input;
+    const bool loaded = load_input(input_file, input);
+    const bool ok = loaded && input.records.size() >= 2;
+    if (rank == 0) {
+        printf("Input: %s\n", input_file.c_str());
+        if (loaded)
+            print_load_info(input);
+        if (loaded && !ok)
+            printf("Error: Input file has fewer than 2 strings: %s\n", input_file.c_str());
+        printf("Ranks: %d, Rows per message: %d\n", num_ranks, rows_per_message);
+    }
+    if (!ok) {
+        MPI_Finalize();
+        return 1;
+    }
+    const std::string_view X = input.records[0];
+    const std::string_view Y = input.records[1];
+
+    int scs_length = run_mpi(alphabet, X, Y, rows_per_message);
+    // the length is on the last rank
+    MPI_Bcast(&scs_length, 1, MPI_INT, num_ranks - 1, MPI_COMM_WORLD);
+    int exit_code = 0;
+    if (scs_length == -2) {
+        if (rank == 0)
+            printf("Error: Unknown alphabet %s or input has chars outside of it\n", alphabet.c_str());
+        exit_code = 1;
+    }
+    else if (rank == 0) {
+        printf("Length of SCS is %d\n", scs_length);
+    }
+    MPI_Finalize();
+    return exit_code;
+}
@@ -1,6 +1,8 @@
 #include <omp.h>
+#include <algorithm>
 #include <string>
-#include <fstream>
+#include "scs_input.h"
+#include <vector>
 
 // #define NUM_THREADS_USED 16
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
@@ -23,7 +25,7 @@ This approach is allowed because the problem satisfies the optimal substructure
 */
 
 // Anti diagonal implementation of SCS
-int scs_anti_diagonal(const std::string &x, const std::string &y) {
+int scs_anti_diagonal(std::string_view x, std::string_view y) {
     // get length of strings x and y
     const int x_len = x.size();
     const int y_len = y.size();
@@ -84,9 +86,102 @@ int scs_anti_diagonal(const std::string &x, const std::string &y) {
 	return tab[x_len][y_len];
 }
 
+/*
+Tiled wavefront implementation of SCS
+The anti-diagonal implementation above has a fork/join + barrier for every single one of the
+x_len + y_len anti-diagonals, each thread only computes one cell per iteration, and walking
+along an anti-diagonal accesses tab column-wise (i.e. one cache line per cell).
+
+Instead, we split tab into tile_size * tile_size tiles. A tile only depends on the tile above
+it and the tile to its left (the tile to its upper left is covered by both), so the tiles form
+the same anti-diagonal wavefront as the cells, just much coarser. Each tile is an OpenMP task
+whose depend clauses encode these 2 edges, so a tile starts as soon as its 2 neighbors are done
+rather than waiting for the whole previous anti-diagonal. Inside a tile the cells are computed
+serially row by row, so the accesses are contiguous and the tile stays in cache.
+*/
+
+// default tile size, 256 * 256 ints = 256 KB, roughly the size of L2 cache
+#define TILE_SIZE 256
+
+int scs_anti_diagonal_tiled(std::string_view x, std::string_view y, const int tile_size) {
+    // get length of strings x and y
+    const int x_len = x.size();
+    const int y_len = y.size();
+    // construct tabulation (memoization), flattened, i.e. tab[a][b] = tab[a * (y_len+1) + b]
+    // on the heap bc it is shared by all the tasks
+    std::vector<int> tab((long long)(x_len + 1) * (y_len + 1));
+    int *t = tab.data();
+    const long long width = y_len + 1;
+    // number of tiles in each dimension, tab has x_len + 1 rows and y_len + 1 cols
+    const int tile_rows = x_len / tile_size + 1;
+    const int tile_cols = y_len / tile_size + 1;
+    // one dependence object per tile, plus one extra that no task writes,
+    // used by the tiles on the edges that have no tile above or to the left
+    std::vector<char> tile_deps(tile_rows * tile_cols + 1);
+    // only used in the depend clauses, which the compiler does not count as a use
+    [[maybe_unused]] char *deps = tile_deps.data();
+    const int no_dep = tile_rows * tile_cols;
+    // timer
+    double start, end;
+    // record start time
+    start = omp_get_wtime();
+#pragma omp parallel
+{
+#pragma omp single
+{
+    // create tasks in anti-diagonal order, so tiles that become ready first are created first
+    for (int d = 0; d < tile_rows + tile_cols - 1; ++d) {
+        for (int ti = std::max(0, d - tile_cols + 1); ti <= std::min(d, tile_rows - 1); ++ti) {
+            const int tj = d - ti;
+            const int curr = ti * tile_cols + tj;
+            const int up = ti > 0 ? curr - tile_cols : no_dep;
+            const int left = tj > 0 ? curr - 1 : no_dep;
+#pragma omp task firstprivate(ti, tj) depend(in: deps[up], deps[left]) depend(out: deps[curr])
+{
+            const int a_end = std::min((ti + 1) * tile_size, x_len + 1);
+            const int b_begin = tj * tile_size;
+            const int b_end = std::min((tj + 1) * tile_size, y_len + 1);
+            // compute the tile serially, row by row
+            for (int a = ti * tile_size; a < a_end; ++a) {
+                int *row = t + a * width;
+                // base case (row 0), it has no row above
+                if (a == 0) {
+                    for (int b = b_begin; b < b_end; ++b)
+                        row[b] = b;
+                    continue;
+                }
+                const int *prev_row = row - width;
+                for (int b = b_begin; b < b_end; ++b) {
+                    // base case
+                    if (b == 0)
+                        row[b] = a;
+                    // case 1
+                    else if (x[a - 1] == y[b - 1])
+                        row[b] = 1 + prev_row[b - 1];
+                    // case 2
+                    else
+                        row[b] = 1 + MIN(row[b - 1], prev_row[b]);
+                }
+            }
+}
+        }
+    }
+}
+}
+    // record end time
+    end = omp_get_wtime();
+    printf("Execution Time (ms) %f\n", (end - start) * 1000.0);
+
+    // output length
+    return t[x_len * width + y_len];
+}
+
+
 int main(int argc, char** argv) {
-    // get input file name from commandline if one is provided
+    // get input file name (and engine, tile size) from commandline if one is provided
     std::string input_file;
+    std::string engine = "anti_diagonal";
+    int tile_size = TILE_SIZE;
     if (argc == 1) {
         // default input file name
         input_file = "input/input-2000.txt";
@@ -94,33 +189,41 @@ int main(int argc, char** argv) {
     else if (argc == 2) {
         input_file = argv[1];
     }
+    else if (argc == 3 || argc == 4) {
+        input_file = argv[1];
+        engine = argv[2];
+        if (argc == 4)
+            tile_size = atoi(argv[3]);
+        if (tile_size <= 0) {
+            printf("Error: Invalid tile size provided\n");
+            return 1;
+        }
+    }
     else {
         printf("Error: Invalid number of arguments provided\n");
-        printf("Usage: ./<program> <input file>\n");
+        printf("Usage: ./<program> <input file> <engine = anti_diagonal(default) | tiled> <tile size = %d(default)>\n", TILE_SIZE);
         return 1;
     }
     printf("Input: %s\n", input_file.c_str());
-    // 2 input strings
-    std::string X = "ozpxennwaelglzwocdybdmpmmcyconwcmlbsaoqcvciidewfiuiljaavcazqnvvbjyvjpmokqwstboa";
-    std::string Y = "iyklqkkdhnvwnrjbxkuyltiaqbllgsipqvaihmlozhnmyypxkjwwegyujjhqepfumhfuvqiuzvixtxxgivcobakllrbriimvrrpmjzgjxqisnfy";
-    // read input string from file
-    std::ifstream fin;
-    fin.open(input_file);
-    // throw error if the file opening fails
-    if (!fin.is_open()) {
-        printf("Error opening file: %s\n", input_file.c_str());
+    // read the 2 input strings from file (views into the mapped file)
+    ScsInput input;
+    if (!load_pair_input(input_file, input))
         return 1;
-    }
-    std::getline(fin, X);
-    std::getline(fin, Y);
-    // printf("Size of X is %d, first char in X is %c\n", X.size(), X[0]);
-    // printf("Size of Y is %d, first char in Y is %c\n", Y.size(), Y[0]);
-    fin.close();
+    const std::string_view X = input.records[0];
+    const std::string_view Y = input.records[1];
 
     // explicitly enable dynamic teams
     // omp_set_dynamic(true);
 
-    int scs_length = scs_anti_diagonal(X, Y);
+    int scs_length;
+    if (engine == "anti_diagonal")
+        scs_length = scs_anti_diagonal(X, Y);
+    else if (engine == "tiled")
+        scs_length = scs_anti_diagonal_tiled(X, Y, tile_size);
+    else {
+        printf("Error: Unknown engine %s\n", engine.c_str());
+        return 1;
+    }
     printf("Length of SCS is %d\n", scs_length);
 
     return 0;
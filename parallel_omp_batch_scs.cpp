@@ -0,0 +1,287 @@
+#include <deque>
+#include <mutex>
+#include <utility>
+#include "parallel_omp_scs.h"
+#include "scs_input.h"
+#include "scs_index.h"
+
+/*
+Batch mode: SCS length of many pairs of strings in one run.
+The input file simply holds the pairs one after the other, i.e. line 2p is X and line 2p+1 is Y
+of pair p (so every input in input/ is also a batch of 1 pair).
+
+Spinning up the whole team of threads for each pair is wasteful when there are many small pairs,
+since each row is then way too short to be worth a barrier. Instead:
+1. Large pairs (at least BATCH_LARGE_CELLS cells) are run one at a time with all threads working on
+   each row, i.e. the intra-pair parallelism of the row-wise independent algorithm.
+2. Small pairs are run one per thread. Each thread starts with its own share of pairs in a deque,
+   takes pairs from the back of its own deque, and once that is empty steals pairs from the front
+   of the deques of other threads, so threads that got cheaper pairs help out the others.
+Each thread keeps its own memo A and 2 rows (ScsScratch) across all the pairs it runs, so there is
+no allocation per pair. Results are stored by the index of the pair, so they are printed in input order.
+
+There is also a one-vs-many mode, where the first line is a query that is compared against each of
+the following lines (targets), using scs_one_vs_many, i.e. many targets in the lanes of a vector.
+The trie mode has the same input (the first line is the reference, the following lines are queries)
+but uses scs_one_vs_many_trie, i.e. queries that share a prefix share the rows of that prefix.
+With SCS_REFERENCE_INDEX=<file> (built by scs_index), memo A of the reference is mapped from that file.
+*/
+
+// pairs with at least this many cells use all threads for each row
+#define BATCH_LARGE_CELLS (1LL << 24)
+
+// deque of indices of pairs owned by one thread
+struct WorkQueue {
+    std::mutex lock;
+    std::deque<int> pairs;
+};
+
+// MODIFIES: queue
+// EFFECTS: takes a pair from the back of the thread's own queue, returns -1 if there is none
+int pop_own(WorkQueue &queue) {
+    std::lock_guard<std::mutex> guard(queue.lock);
+    if (queue.pairs.empty())
+        return -1;
+    int pair = queue.pairs.back();
+    queue.pairs.pop_back();
+    return pair;
+}
+
+// MODIFIES: queue
+// EFFECTS: steals a pair from the front of another thread's queue, returns -1 if there is none
+int steal(WorkQueue &queue) {
+    std::lock_guard<std::mutex> guard(queue.lock);
+    if (queue.pairs.empty())
+        return -1;
+    int pair = queue.pairs.front();
+    queue.pairs.pop_front();
+    return pair;
+}
+
+// MODIFIES: lengths
+// EFFECTS: computes the length of SCS of every pair into lengths (same order as pairs)
+template <typename Alphabet>
+void scs_batch(const std::vector<std::pair<PackedString<Alphabet>, PackedString<Alphabet>>> &pairs,
+               std::vector<int> &lengths, int &num_large) {
+    const int num_pairs = pairs.size();
+    const int num_threads = omp_get_max_threads();
+    lengths.assign(num_pairs, 0);
+    // one queue and one set of buffers for each thread
+    std::vector<WorkQueue> queues(num_threads);
+    std::vector<ScsScratch> scratches(num_threads);
+    // Step 1: large pairs, one at a time with all threads
+    num_large = 0;
+    int next_queue = 0;
+    for (int p = 0; p < num_pairs; ++p) {
+        if ((long long)pairs[p].first.size() * pairs[p].second.size() >= BATCH_LARGE_CELLS) {
+            lengths[p] = scs_rowwise_independent_linear<Alphabet>(pairs[p].first, pairs[p].second, scratches[0]);
+            ++num_large;
+        }
+        else {
+            // hand out small pairs round robin
+            queues[next_queue].pairs.push_back(p);
+            next_queue = (next_queue + 1) % num_threads;
+        }
+    }
+    // Step 2: small pairs, one per thread with work-stealing
+#pragma omp parallel num_threads(num_threads)
+{
+    const int tid = omp_get_thread_num();
+    ScsScratch &scratch = scratches[tid];
+    while (true) {
+        int p = pop_own(queues[tid]);
+        // own queue is empty, try to steal from the others
+        for (int victim = 1; p < 0 && victim < num_threads; ++victim)
+            p = steal(queues[(tid + victim) % num_threads]);
+        // nothing left anywhere (no new pairs are ever added)
+        if (p < 0)
+            break;
+        lengths[p] = scs_rowwise_independent_serial<Alphabet>(pairs[p].first, pairs[p].second, scratch);
+    }
+}
+}
+
+// EFFECTS: packs all the pairs of the input, runs the batch and prints the results,
+//          returns false if the input has an odd number of strings or a string has chars outside of Alphabet
+template <typename Alphabet>
+bool run_batch(const ScsInput &input) {
+    // line 2p is X and line 2p+1 is Y of pair p, so the last string would have no pair
+    if (input.records.size() % 2 != 0) {
+        printf("Error: Input file has an odd number of strings (%zu), every pair needs 2\n", input.records.size());
+        return false;
+    }
+    std::vector<std::pair<PackedString<Alphabet>, PackedString<Alphabet>>> pairs;
+    for (size_t r = 0; r + 1 < input.records.size(); r += 2) {
+        const std::string_view X = input.records[r], Y = input.records[r + 1];
+        if (!Alphabet::valid(X) || !Alphabet::valid(Y)) {
+            printf("Error: Pair %zu has chars outside of alphabet %s\n", pairs.size(), Alphabet::NAME);
+            return false;
+        }
+        pairs.emplace_back(PackedString<Alphabet>(X), PackedString<Alphabet>(Y));
+    }
+    printf("Alphabet: %s (%d bits per char)\n", Alphabet::NAME, Alphabet::BITS);
+    std::vector<int> lengths;
+    int num_large;
+    double start, end;
+    // record start time
+    start = omp_get_wtime();
+    scs_batch<Alphabet>(pairs, lengths, num_large);
+    // record end time
+    end = omp_get_wtime();
+    // results in input order
+    for (size_t p = 0; p < lengths.size(); ++p)
+        printf("Length of SCS of pair %zu is %d\n", p, lengths[p]);
+    printf("Number of pairs %zu (%d large)\n", pairs.size(), num_large);
+    printf("Execution Time (ms) %f\n", (end - start) * 1000.0);
+    printf("Throughput (pairs/s) %f\n", pairs.size() / (end - start));
+    return true;
+}
+
+// EFFECTS: packs the query and all the targets of the input, runs them and prints the results,
+//          returns false if a string has chars outside of Alphabet
+template <typename Alphabet>
+bool run_one_vs_many(const ScsInput &input) {
+    if (input.records.empty() || !Alphabet::valid(input.records[0])) {
+        printf("Error: Query is missing or has chars outside of alphabet %s\n", Alphabet::NAME);
+        return false;
+    }
+    const PackedString<Alphabet> query(input.records[0]);
+    std::vector<PackedString<Alphabet>> targets;
+    for (size_t r = 1; r < input.records.size(); ++r) {
+        if (!Alphabet::valid(input.records[r])) {
+            printf("Error: Target %zu has chars outside of alphabet %s\n", targets.size(), Alphabet::NAME);
+            return false;
+        }
+        targets.emplace_back(input.records[r]);
+    }
+    printf("Alphabet: %s (%d bits per char)\n", Alphabet::NAME, Alphabet::BITS);
+    std::vector<int> lengths;
+    double start, end;
+    // record start time
+    start = omp_get_wtime();
+    scs_one_vs_many<Alphabet>(query, targets, lengths);
+    // record end time
+    end = omp_get_wtime();
+    // results in input order
+    for (size_t t = 0; t < lengths.size(); ++t)
+        printf("Length of SCS of target %zu is %d\n", t, lengths[t]);
+    printf("Number of targets %zu\n", targets.size());
+    printf("Execution Time (ms) %f\n", (end - start) * 1000.0);
+    printf("Throughput (pairs/s) %f\n", targets.size() / (end - start));
+    return true;
+}
+
+// EFFECTS: packs the reference and all the queries of the input, runs them through the prefix trie
+//          and prints the results, returns false if a string has chars outside of Alphabet
+template <typename Alphabet>
+bool run_trie(const ScsInput &input) {
+    if (input.records.empty() || !Alphabet::valid(input.records[0])) {
+        printf("Error: Reference is missing or has chars outside of alphabet %s\n", Alphabet::NAME);
+        return false;
+    }
+    const PackedString<Alphabet> reference(input.records[0]);
+    std::vector<PackedString<Alphabet>> queries;
+    long long query_chars = 0;
+    for (size_t r = 1; r < input.records.size(); ++r) {
+        if (!Alphabet::valid(input.records[r])) {
+            printf("Error: Query %zu has chars outside of alphabet %s\n", queries.size(), Alphabet::NAME);
+            return false;
+        }
+        queries.emplace_back(input.records[r]);
+        query_chars += input.records[r].size();
+    }
+    printf("Alphabet: %s (%d bits per char)\n", Alphabet::NAME, Alphabet::BITS);
+    // memo A of the reference from its index file, if there is one for it
+    const char *index_file = getenv("SCS_REFERENCE_INDEX");
+    ReferenceIndex index;
+    bool use_index = false;
+    if (index_file != nullptr) {
+        std::string error;
+        if (!index.open(index_file, error))
+            printf("Error: Reference index %s: %s, building memo A instead\n", index_file, error.c_str());
+        else if (!index.matches<Alphabet>(reference))
+            printf("Error: Reference index %s is for a different reference or alphabet, building memo A instead\n", index_file);
+        else {
+            use_index = true;
+            printf("Reference Index: %s (%d bits per entry)\n", index_file, 8 * index.header().entry_bytes);
+        }
+    }
+    std::vector<int> lengths;
+    int num_nodes;
+    long long num_rows;
+    double start, end;
+    // record start time
+    start = omp_get_wtime();
+    if (!use_index)
+        num_rows = scs_one_vs_many_trie<Alphabet>(reference, queries, lengths, num_nodes);
+    else if (index.header().entry_bytes == 2)
+        num_rows = scs_one_vs_many_trie<Alphabet>(index.table<uint16_t>(), index.header().stride, reference.size(), queries, lengths, num_nodes);
+    else
+        num_rows = scs_one_vs_many_trie<Alphabet>(index.table<uint32_t>(), index.header().stride, reference.size(), queries, lengths, num_nodes);
+    // record end time
+    end = omp_get_wtime();
+    // results in input order
+    for (size_t q = 0; q < lengths.size(); ++q)
+        printf("Length of SCS of query %zu is %d\n", q, lengths[q]);
+    printf("Number of queries %zu (%lld chars), Trie Nodes %d, Rows Computed %lld\n", queries.size(), query_chars, num_nodes, num_rows);
+    printf("Execution Time (ms) %f\n", (end - start) * 1000.0);
+    printf("Throughput (pairs/s) %f\n", queries.size() / (end - start));
+    return true;
+}
+
+// EFFECTS: runs the given mode with the alphabet of the given name
+template <typename Alphabet>
+bool run_mode(const std::string &mode, const ScsInput &input) {
+    if (mode == "pairs")
+        return run_batch<Alphabet>(input);
+    if (mode == "one_vs_many")
+        return run_one_vs_many<Alphabet>(input);
+    if (mode == "trie")
+        return run_trie<Alphabet>(input);
+    printf("Error: Unknown mode %s\n", mode.c_str());
+    return false;
+}
+
+int main(int argc, char** argv) {
+    // get input file name (and alphabet, mode) from commandline if one is provided
+    std::string input_file;
+    std::string alphabet = LowercaseAlphabet::NAME;
+    std::string mode = "pairs";
+    if (argc == 1) {
+        // default input file name
+        input_file = "input/input-2000.txt";
+    }
+    else if (argc >= 2 && argc <= 4) {
+        input_file = argv[1];
+        if (argc >= 3)
+            alphabet = argv[2];
+        if (argc == 4)
+            mode = argv[3];
+    }
+    else {
+        printf("Error: Invalid number of arguments provided\n");
+        printf("Usage: ./<program> <input file with pairs> <alphabet = lowercase(default) | dna | protein | byte> <mode = pairs(default) | one_vs_many | trie>\n");
+        return 1;
+    }
+    printf("Input: %s\n", input_file.c_str());
+    // read input strings from file (views into the mapped file)
+    ScsInput input;
+    if (!load_input(input_file, input))
+        return 1;
+    print_load_info(input);
+    bool ok;
+    if (alphabet == LowercaseAlphabet::NAME)
+        ok = run_mode<LowercaseAlphabet>(mode, input);
+    else if (alphabet == DnaAlphabet::NAME)
+        ok = run_mode<DnaAlphabet>(mode, input);
+    else if (alphabet == ProteinAlphabet::NAME)
+        ok = run_mode<ProteinAlphabet>(mode, input);
+    else if (alphabet == ByteAlphabet::NAME)
+        ok = run_mode<ByteAlphabet>(mode, input);
+    else {
+        printf("Error: Unknown alphabet %s\n", alphabet.c_str());
+        ok = false;
+    }
+
+    return ok ? 0 : 1;
+}
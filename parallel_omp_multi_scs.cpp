@@ -0,0 +1,229 @@
+#include "parallel_omp_scs.h"
+#include "scs_input.h"
+
+/*
+SCS of k > 2 strings.
+Finding the optimal SCS of k strings is NP-hard, so instead we use one of two heuristics,
+both built from the pairwise engines in parallel_omp_scs.h.
+
+1. Greedy pairwise merging
+   Repeatedly pick the 2 strings whose (pairwise) SCS is the shortest, and replace both of them
+   with their SCS, until only 1 string is left. Since the SCS of 2 strings is a supersequence
+   of both, the last string is a supersequence of all k strings.
+   - The k * k matrix of pairwise SCS lengths is computed upfront in parallel, one pair per
+     thread (row-wise independent algorithm, 2 rows, each thread reusing its own buffers).
+   - After a merge, only the scores that involve the merged string are out of date, so only
+     these (at most k-2) are re-scored (in parallel), instead of the whole matrix again.
+   - The merge itself uses Hirschberg's approach, i.e. all threads work on that one pair.
+
+2. Majority merge
+   Repeatedly look at the first char of every remaining string, append the char that most of
+   them start with to the SCS, and remove it from the front of each string that starts with it.
+   The strings are kept in one bucket per char (by their current first char), so the count of
+   each char is simply the size of its bucket, and each step only moves the strings that start
+   with the chosen char to their new bucket. Thus the whole merge takes O(total length) time.
+*/
+
+// MODIFIES: scores
+// EFFECTS: computes scores[a][b] = |SCS(strings[a], strings[b])| for every a in rows and every
+//          alive b != a, with one pair per thread
+template <typename Alphabet>
+void score_pairs(const std::vector<std::string> &strings, const std::vector<bool> &alive,
+                 const std::vector<int> &rows, std::vector<std::vector<int>> &scores,
+                 std::vector<ScsScratch> &scratches) {
+    const int k = strings.size();
+    std::vector<bool> in_rows(k, false);
+    for (int a : rows)
+        in_rows[a] = true;
+    // list all the pairs to score, each one only once
+    std::vector<std::pair<int, int>> pairs;
+    for (int a : rows) {
+        for (int b = 0; b < k; ++b) {
+            if (alive[b] && b != a && !(b < a && in_rows[b]))
+                pairs.emplace_back(a, b);
+        }
+    }
+#pragma omp parallel for schedule(dynamic)
+    for (size_t p = 0; p < pairs.size(); ++p) {
+        const int a = pairs[p].first;
+        const int b = pairs[p].second;
+        ScsScratch &scratch = scratches[omp_get_thread_num()];
+        scores[a][b] = scores[b][a] = scs_rowwise_independent_serial<Alphabet>(strings[a], strings[b], scratch);
+    }
+}
+
+// EFFECTS: returns a supersequence of all strings using greedy pairwise merging
+template <typename Alphabet>
+std::string scs_greedy_merge(std::vector<std::string> strings) {
+    const int k = strings.size();
+    std::vector<bool> alive(k, true);
+    std::vector<std::vector<int>> scores(k, std::vector<int>(k, 0));
+    std::vector<ScsScratch> scratches(omp_get_max_threads());
+    double start, end, merge_ms = 0, rescore_ms = 0;
+    // Phase 1: all pairwise scores
+    start = omp_get_wtime();
+    std::vector<int> all_rows(k);
+    for (int a = 0; a < k; ++a)
+        all_rows[a] = a;
+    score_pairs<Alphabet>(strings, alive, all_rows, scores, scratches);
+    end = omp_get_wtime();
+    printf("Pairwise Scores Time (ms) %f\n", (end - start) * 1000.0);
+    // Phase 2: k-1 merges
+    for (int merges = 0; merges < k - 1; ++merges) {
+        // pick the pair with the shortest SCS
+        int best_a = -1, best_b = -1;
+        for (int a = 0; a < k; ++a) {
+            if (!alive[a])
+                continue;
+            for (int b = a + 1; b < k; ++b) {
+                if (alive[b] && (best_a < 0 || scores[a][b] < scores[best_a][best_b])) {
+                    best_a = a;
+                    best_b = b;
+                }
+            }
+        }
+        // replace a with the SCS of a and b
+        start = omp_get_wtime();
+        strings[best_a] = find_scs_hirschberg<Alphabet>(strings[best_a], strings[best_b]);
+        alive[best_b] = false;
+        strings[best_b].clear();
+        end = omp_get_wtime();
+        merge_ms += (end - start) * 1000.0;
+        // only the scores of the merged string have changed
+        start = omp_get_wtime();
+        score_pairs<Alphabet>(strings, alive, std::vector<int>(1, best_a), scores, scratches);
+        end = omp_get_wtime();
+        rescore_ms += (end - start) * 1000.0;
+    }
+    printf("Merging Time (ms) %f\n", merge_ms);
+    printf("Re-scoring Time (ms) %f\n", rescore_ms);
+    for (int a = 0; a < k; ++a) {
+        if (alive[a])
+            return strings[a];
+    }
+    return "";
+}
+
+// EFFECTS: returns a supersequence of all strings using majority merge
+template <typename Alphabet>
+std::string scs_majority_merge(const std::vector<std::string> &strings) {
+    const int k = strings.size();
+    double start, end;
+    start = omp_get_wtime();
+    // position of the current first char of each string
+    std::vector<size_t> pos(k, 0);
+    // strings by their current first char
+    std::vector<std::vector<int>> buckets(Alphabet::SIZE);
+    size_t total_length = 0;
+    for (int a = 0; a < k; ++a) {
+        if (!strings[a].empty())
+            buckets[symbol_idx<Alphabet>(strings[a], 0)].push_back(a);
+        total_length += strings[a].size();
+    }
+    std::string scs;
+    scs.reserve(total_length);
+    std::vector<int> moving;
+    while (true) {
+        // char that most strings start with
+        int best = 0;
+        for (int c = 1; c < Alphabet::SIZE; ++c) {
+            if (buckets[c].size() > buckets[best].size())
+                best = c;
+        }
+        // all strings are used up
+        if (buckets[best].empty())
+            break;
+        scs.push_back(Alphabet::symbol(best));
+        // move the strings that start with it to the bucket of their next char
+        moving.swap(buckets[best]);
+        for (int a : moving) {
+            if (++pos[a] < strings[a].size())
+                buckets[symbol_idx<Alphabet>(strings[a], pos[a])].push_back(a);
+        }
+        moving.clear();
+    }
+    end = omp_get_wtime();
+    printf("Majority Merge Time (ms) %f\n", (end - start) * 1000.0);
+    return scs;
+}
+
+// EFFECTS: runs the heuristic on the strings and prints the results,
+//          returns false if the method is unknown or a string has chars outside of Alphabet
+template <typename Alphabet>
+bool run_multi(const std::string &method, const std::vector<std::string> &strings) {
+    for (size_t a = 0; a < strings.size(); ++a) {
+        if (!Alphabet::valid(strings[a])) {
+            printf("Error: String %zu has chars outside of alphabet %s\n", a, Alphabet::NAME);
+            return false;
+        }
+    }
+    printf("Alphabet: %s, Number of strings %zu\n", Alphabet::NAME, strings.size());
+    std::string scs;
+    double start, end;
+    // record start time
+    start = omp_get_wtime();
+    if (method == "greedy")
+        scs = scs_greedy_merge<Alphabet>(strings);
+    else if (method == "majority")
+        scs = scs_majority_merge<Alphabet>(strings);
+    else {
+        printf("Error: Unknown method %s\n", method.c_str());
+        return false;
+    }
+    // record end time
+    end = omp_get_wtime();
+    printf("Execution Time (ms) %f\n", (end - start) * 1000.0);
+    bool is_supersequence = true;
+    for (const std::string &s : strings)
+        is_supersequence = is_supersequence && is_subsequence(s, scs);
+    printf("Is supersequence: %s\n", is_supersequence ? "true" : "false");
+    printf("SCS is %s\n", scs.c_str());
+    printf("Length of SCS is %zu\n", scs.size());
+    return true;
+}
+
+int main(int argc, char** argv) {
+    // get input file name (and method, alphabet) from commandline if one is provided
+    std::string input_file;
+    std::string method = "greedy";
+    std::string alphabet = LowercaseAlphabet::NAME;
+    if (argc == 1) {
+        // default input file name
+        input_file = "input/input-2000.txt";
+    }
+    else if (argc >= 2 && argc <= 4) {
+        input_file = argv[1];
+        if (argc >= 3)
+            method = argv[2];
+        if (argc == 4)
+            alphabet = argv[3];
+    }
+    else {
+        printf("Error: Invalid number of arguments provided\n");
+        printf("Usage: ./<program> <input file, one string per line> <method = greedy(default) | majority> <alphabet = lowercase(default) | dna | protein | byte>\n");
+        return 1;
+    }
+    printf("Input: %s\n", input_file.c_str());
+    // read input strings from file, copied since the merges replace them
+    ScsInput input;
+    if (!load_input(input_file, input))
+        return 1;
+    print_load_info(input);
+    const std::vector<std::string> strings(input.records.begin(), input.records.end());
+
+    bool ok;
+    if (alphabet == LowercaseAlphabet::NAME)
+        ok = run_multi<LowercaseAlphabet>(method, strings);
+    else if (alphabet == DnaAlphabet::NAME)
+        ok = run_multi<DnaAlphabet>(method, strings);
+    else if (alphabet == ProteinAlphabet::NAME)
+        ok = run_multi<ProteinAlphabet>(method, strings);
+    else if (alphabet == ByteAlphabet::NAME)
+        ok = run_multi<ByteAlphabet>(method, strings);
+    else {
+        printf("Error: Unknown alphabet %s\n", alphabet.c_str());
+        ok = false;
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,2581 @@
+#ifndef PARALLEL_OMP_SCS_H
+#define PARALLEL_OMP_SCS_H
+
+#include <omp.h>
+#include <algorithm>
+#include <string>
+#include <cassert>
+#include <vector>
+#include <cstdint>
+#include <immintrin.h>
+#include <atomic>
+#include <sched.h>
+#include "scs_alphabet.h"
+#include "scs_perf.h"
+#include "scs_numa.h"
+#include "scs_checkpoint.h"
+#include "scs_band.h"
+
+// #define NUM_THREADS_USED 16
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+
+// the alphabet (C) is a template parameter of the engines, see scs_alphabet.h
+// static int NUM_THREADS_USED = 16;
+// new plan: specify environment variable using OMP_NUM_THREADS in command line or shell script
+
+/* Original Recurrence Relation for finding SCS
+Shortest Common Supersequence of 2 strings X, Y can be expressed using a recurrence relation.
+Base case: If X or Y has length 0, then the SCS is simply the other string.
+Let a, b denote the last symbol in X and Y respectively,
+Case 1: If the last symbol in X and Y are the same, i.e. a == b,
+        then SCS(X, Y) = SCS(X-a, Y-b) + a, i.e. it is the SCS of both strings without
+        their last symbol, concatenated with this last symbol once.
+Case 2: If the last symbol in X and Y are NOT the same, i.e. a != b,
+        then SCS(X, Y) = MIN{ SCS(X-a,Y) + a, SCS(X,Y-b) + b }, i.e. find the SCS between
+        one string remaining the same but excluding the last symbol of the other string,
+        concatenated with the symbol that was excluded.
+This approach is allowed because the problem satisfies the optimal substructure property of DP.
+*/
+
+
+/* Reformulated Recurrence Relation for finding SCS
+Originally, Case 2 requires each entry to look at the entry to its left on the same row.
+So each entry [i][j], is dependent on [i-1][j], [i-1][j-1], and [i][j-1];
+this makes the relation having data dependency both row-wise and column-wise.
+However, we make the claim that the tabulation can actually be row-wise independent, i.e.
+the ith row data can be calculated just based on the (i − 1)th row data!
+
+To do this, we need to reformulate Case 2, specifically, somehow to not use tab[i][j-1].
+We make an observation that tab[i][j-1] can only be one of the following:
+1. tab[i][j-1] = i                                  if j-1 = 0
+2. tab[i][j-1] = tab[i-1][j-2] + 1                  if X[i] = Y[j-1]
+3. tab[i][j-1] = min{tab[i-1][j-1], tab[i][j-2]}    otherwise
+Note that case 3 requires tab[i][j-2] which is on the same row again, but we can simply
+do recursion using this formula until we get to either case 1 or 2!
+
+In other words, we can think of this as we just keep going left 1 char or col at a time, until
+we eventually no longer need to use the entry on the same row by either
+1. Reach the leftmost column, or
+2. Reach a character in string Y (i.e. at location j - k) that is the same as the current
+   character in string X (i.e. at location i).
+
+Thus, we can substitute tab[i][j-1] in Case 2 or the original recurrence relation as the following:
+- tab[i][j-1] = i + k - 1               if j-k = 0
+- tab[i][j-1] = tab[i-1][j-k-1] + k     if X[i] = Y[j-k]
+where k is the minimum number of chars we look left until either one of the two cases in the
+previous paragraph becomes true.
+
+The scs_rowwise_independent function implements this approach.
+
+Note that in the actual implementation, we are actually comparing X[i-1] and Y[i-1-k]
+bc the strings are 0-based indexing whereas the tabulation is 1-based indexing because
+of "the ghost cells" padding to account for the base case of scs.
+*/
+
+inline int scs_rowwise_independent(const std::string &s1, const std::string &s2) {
+    // get length of both strings
+    int n = s1.size();
+    int m = s2.size();
+    // create tabulation (memoization)
+    int tab[n+1][m+1];
+    // use bottom up iteration to find the optimal length of SCS
+    for (int i = 0; i < n + 1; ++i) {
+        for (int j = 0; j < m + 1; ++j) {
+            // both base cases and case 1 do not need to access anything from current row
+            if (i == 0) {
+                tab[i][j] = j;
+            }
+            else if (j == 0) {
+                tab[i][j] = i;
+            }
+            else if (s1[i-1] == s2[j-1]) {
+                tab[i][j] = 1 + tab[i-1][j-1];
+            }
+            // only case two needs to access from current row
+            // use new formula
+            else if (s1[i-1] != s2[j-1]) {
+                printf("Row: %d, Col: %d; ", i, j);
+                // first find k
+                int k = 1;
+                int tab_i_j_1;
+                while (true) {
+                    if (j - k == 0) {
+                        tab_i_j_1 = i + k - 1;
+                        // printf("Reached edge of column");
+                        break;
+                    }
+                    else if (s1[i-1] == s2[j-1-k]) {
+                        tab_i_j_1 = tab[i-1][j-k-1] + k;
+                        // printf("Found matching symbol");
+                        break;
+                    }
+                    else {
+                        ++k;
+                    }
+                }
+                printf(" j - k = %d ", j - k);
+                printf("found k = %d, tab[i][j-1] = %d\n", k, tab_i_j_1);
+                tab[i][j] = 1 + std::min(tab_i_j_1, tab[i-1][j]);
+            }
+        }
+    }
+    // DEBUG
+    for (int i = 0; i <= n; ++i) {
+        for (int j = 0; j <= m; ++j) {
+            printf("%d ", tab[i][j]);
+        }
+        printf("\n");
+    }
+    // END DEBUG
+    // output length
+    return tab[n][m];
+}
+
+/*
+The above row-wise implementation does remove the data dependency in the same row.
+However, the process of looking for k can be slow, especially when string Y is large.
+We can preprocess another matrix/tabulation for computing/storing j - k,
+let's call this matrix P.
+
+Let C be a finite alphabet for the input strings, C[1,...,l]
+Let 1 <= i <= l, 0 <= j <= m
+Define matrix/tabulation P[l+1][m+1] (i.e. row=each char in alphabet, col=each char in string Y),
+1. P[i][j] = 0              if j = 0
+2. P[i][j] = j - 1          if Y[j-1] = C[i]
+3. P[i][j] = P[i][j-1]      otherwise
+
+As a result, P[i][j] indicates the closest index (to index j) in string Y such that
+1. this index either equals to 0 (we have reached the edge column, i.e. no matching
+   chars between anything before index j in string Y and C[i]), or
+2. the char at this index in string Y equals to C[i] (we found a matching char)
+These two conditions parallel the two stopping conditions in the recurrence relation for
+tab[i][j-1] in the previous block of comment.
+In other words, P[i][j] equals to j - k.
+
+Note that filling out the matrix P is column-wise independent, which can also be parallelized.
+But bc cache is stored contiguous as rows in C, it is better to flip the row and column of P
+when actually implementing this approach.
+
+Lastly, we can replace the j - k in the recurrence relation for tab[i][j-1] in the previous
+block of comment with the following:
+- tab[i][j-1] = i + j - 1                                if P[c][j] = 0
+- tab[i][j-1] = tab[i-1][P[c][j]-1] + (j-P[c][j]-1])     if X[i] = Y[P[c][j]]
+*/
+
+// REQUIRES: letter is in Alphabet
+// MODIFIES: none
+// EFFECTS: returns 0-based indexing for the letter, e.g., for [a-z] a=0, b=1, ...
+template <typename Alphabet>
+int convert_letter_to_idx(const char letter) {
+    // sanity check
+    assert(Alphabet::to_idx(letter) >= 0);
+    return Alphabet::to_idx(letter);
+}
+
+// REQUIRES: stride >= m+1
+// MODIFIES: A
+// EFFECTS: fills out memo A (j-k values) of string Y, A is flattened, i.e. A[c][j] = A[c * stride + j],
+//          one thread for each letter in the alphabet (up to the number of cores)
+template <typename Alphabet, typename Seq>
+void compute_j_minus_k(const Seq &s2, int *A, const int stride) {
+    const int m = s2.size();
+#pragma omp parallel for num_threads(MIN(Alphabet::SIZE, omp_get_num_procs()))
+    for (int c = 0; c < Alphabet::SIZE; ++c) {
+        int *A_c = &A[(size_t)c * stride];
+        // first column is always 0 bc it represents the empty string s2
+        A_c[0] = 0;
+        for (int j = 1; j <= m; ++j)
+            // note: no -1 here bc we do -1 later when indexing into s2
+            A_c[j] = (symbol_idx<Alphabet>(s2, j-1) == c) ? j : A_c[j-1];
+    }
+}
+
+// MODIFIES: A
+// EFFECTS: same as above with rows right after each other, i.e. A[c][j] = A[c * (m+1) + j]
+template <typename Alphabet, typename Seq>
+void compute_j_minus_k(const Seq &s2, int *A) {
+    compute_j_minus_k<Alphabet>(s2, A, s2.size() + 1);
+}
+
+template <typename Alphabet>
+int scs_rowwise_independent_w_two_memos(const std::string &s1, const std::string &s2) {
+    // get length of both strings
+    int n = s1.size();
+    int m = s2.size();
+    // create tabulation (memoization)
+    int P[Alphabet::SIZE][m+1];
+    int tab[n+1][m+1];
+    // Step 1: fill out j-k values (see block of comments above for more info)
+    for (int i = 0; i < Alphabet::SIZE; ++i) {
+        // first column is always 0 bc it represents the empty string s2
+        P[i][0] = 0;
+        for (int j = 1; j <= m; ++j) {
+            if (s2[j-1] == Alphabet::symbol(i))
+                // note: no -1 here bc we do -1 later when indexing into s2
+                P[i][j] = j;
+            else
+                P[i][j] = P[i][j-1];
+        }
+    }
+    // DEBUG
+    // for (int i = 0; i < Alphabet::SIZE; ++i) {
+    //     printf("%c ", Alphabet::symbol(i));
+    //     for (int j = 0; j <= m; ++j) {
+    //         printf("%d ", P[i][j]);
+    //     }
+    //     printf("\n");
+    // }
+    // END DEBUG
+
+    // Step 2: use bottom up iteration to find the optimal length of SCS
+    for (int i = 0; i < n + 1; ++i) {
+        for (int j = 0; j < m + 1; ++j) {
+            // both base cases and case 1 do not need to access anything from current row
+            if (i == 0) {
+                tab[i][j] = j;
+            }
+            else if (j == 0) {
+                tab[i][j] = i;
+            }
+            else if (s1[i-1] == s2[j-1]) {
+                tab[i][j] = 1 + tab[i-1][j-1];
+            }
+            // only case two needs to access from current row
+            // use new formula
+            else {
+                // printf("Row: %d, Col: %d; ", i, j);
+                // first find k
+                int j_minus_k = P[convert_letter_to_idx<Alphabet>(s1[i-1])][j];
+                // printf(" j - k = %d ", j_minus_k);
+                int k = j - j_minus_k;
+                int tab_i_j_minus_1;
+                // tab[i][j-1] = i + j - 1                                if P[c][j] = 0
+                // tab[i][j-1] = tab[i-1][P[c][j]-1] + (j-P[c][j]-1])     if X[i] = Y[P[c][j]]
+                if (j_minus_k == 0) {
+                    tab_i_j_minus_1 = i + k - 1;
+                    // printf("Reached edge of column");
+                }
+                else if (s1[i-1] == s2[j_minus_k-1]) {
+                    tab_i_j_minus_1 = tab[i-1][j_minus_k-1] + k;
+                    // printf("Found matching symbol");
+                }
+                // printf("found k = %d, tab[i][j-1] = %d\n", k, tab_i_j_minus_1);
+                tab[i][j] = 1 + std::min(tab_i_j_minus_1, tab[i-1][j]);
+            }
+        }
+    }
+    // DEBUG
+    for (int i = 0; i <= n; ++i) {
+        for (int j = 0; j <= m; ++j) {
+            printf("%d ", tab[i][j]);
+        }
+        printf("\n");
+    }
+    // END DEBUG
+    // output length
+    return tab[n][m];
+}
+
+/*
+The algorithm below presents further optimized code with less conditional branches.
+*/
+
+template <typename Alphabet, typename Seq>
+int scs_rowwise_independent_optimal(const Seq &s1, const Seq &s2) {
+    // get length of both strings
+    int n = s1.size();
+    int m = s2.size();
+    // create tabulation (memoization)
+    int P[Alphabet::SIZE][m+1];
+    int tab[n+1][m+1];
+    double start, end;
+    // record start time
+    start = omp_get_wtime();
+    // Step 1: fill out j-k values (see block of comments above for more info)
+    //      spawn one thread for each letter, each thread do the inner loop
+    compute_j_minus_k<Alphabet>(s2, &P[0][0]);
+
+    // Step 2: use bottom up iteration to find the optimal length of SCS
+    int i = 1;
+    // using omp parallel outside to minimize threads generation for each inner loop
+// #pragma omp parallel num_threads(NUM_THREADS_USED)
+#pragma omp parallel
+{
+    // printf("sanity check, number of threads: %d\n", omp_get_num_threads());
+    // calculate base case (row 0) first
+    // TODO: parallelize here or this can be considered as part of the initialization of tab
+#pragma omp for schedule(static)
+    for (int j = 0; j <= m; ++j) {
+        tab[0][j] = j;
+    }
+    // then iteratively calculate remaining rows
+    while (i <= n) {
+        // index of X[i-1] in the alphabet
+        const int c = symbol_idx<Alphabet>(s1, i-1);
+        // base case (col 0)
+        tab[i][0] = i;
+        // TODO: can parallelize the inner loop
+#pragma omp for schedule(static)
+        for (int j = 1; j <= m; ++j) {
+            // printf("Thread Idx: %d, Row: %d Col: %d\n", omp_get_thread_num(), i, j);
+            // first find k
+            int j_minus_k = P[c][j];
+            int k = j - j_minus_k;
+            int tab_i_j_minus_1;
+            if (j_minus_k == 0)
+                // reached edge of column
+                tab_i_j_minus_1 = i + k - 1;
+            else
+                // found matching symbol
+                tab_i_j_minus_1 = tab[i-1][j_minus_k-1] + k;
+            // compute current value in tab
+            tab[i][j] = 1 + MIN(tab_i_j_minus_1, tab[i-1][j]);
+        }
+#pragma omp single
+        ++i;
+    }
+}
+    // END DEBUG
+    // record end time
+    end = omp_get_wtime();
+    // DEBUG
+    // for (int i = 0; i <= n; ++i) {
+    //     for (int j = 0; j <= m; ++j) {
+    //         printf("%d ", tab[i][j]);
+    //     }
+    //     printf("\n");
+    // }
+    printf("Execution Time (ms) %f\n", (end - start) * 1000.0);
+    // output length
+    return tab[n][m];
+}
+
+template <typename Alphabet, typename Seq>
+int scs_rowwise_independent_no_branch(const Seq &s1, const Seq &s2) {
+    // get length of both strings
+    const int n = s1.size();
+    const int m = s2.size();
+    // create memoization
+    int A[Alphabet::SIZE][m+1];
+    int tab[n+1][m+1];
+    double start, end;
+    // record start time
+    start = omp_get_wtime();
+    // Step 1: fill out j-k values in first memo (see paper)
+    // spawn one thread for each letter, each thread do the inner loop
+    compute_j_minus_k<Alphabet>(s2, &A[0][0]);
+
+    // Step 2: use bottom up iteration to find the optimal length of SCS
+    int i = 1;
+    // opt: using omp parallel outside to minimize threads generation for each inner loop
+// #pragma omp parallel num_threads(NUM_THREADS_USED)
+#pragma omp parallel
+{
+    // opt: calculate base case (row 0) first
+#pragma omp for schedule(static)
+    for (int j = 0; j <= m; ++j) {
+        tab[0][j] = j;
+    }
+    // then iteratively calculate remaining rows
+    while (i <= n) {
+        // index of X[i-1] in the alphabet
+        const int c = symbol_idx<Alphabet>(s1, i-1);
+        // base case (col 0)
+        tab[i][0] = i;
+#pragma omp for schedule(static)
+        for (int j = 1; j <= m; ++j) {
+            // first find k
+            int j_minus_k = A[c][j];
+
+            // rely solely on boolean logic
+            bool found_matching = j_minus_k > 0;
+            bool i_minus_1_leq_j_minus_1 = found_matching * (tab[i-1][j] <= tab[i-1][j_minus_k-1] + (j - j_minus_k))
+                                            + !found_matching * (tab[i-1][j] <= i + j - 1);
+            // observation: the difference between [i-1][j] and [i][j-1] is at most 1
+            // we can simply use tab[i-1][j] to compute tab[i][j]
+            // if tab[i-1][j] <= tab_i_j_minus_1, then simply add 1 as normal
+            // otherwise, we know that tab[i-1][j] = tab_i_j_minus_1 + 1,
+            // so we simply do not need to add 1 to it
+            tab[i][j] = tab[i-1][j] + i_minus_1_leq_j_minus_1;
+        }
+#pragma omp single
+        ++i;
+    }
+}
+    // END DEBUG
+    // record end time
+    end = omp_get_wtime();
+    // DEBUG
+    // for (int i = 0; i <= n; ++i) {
+    //     for (int j = 0; j <= m; ++j) {
+    //         printf("%d ", tab[i][j]);
+    //     }
+    //     printf("\n");
+    // }
+    printf("Execution Time (ms) %f\n", (end - start) * 1000.0);
+    // output length
+    return tab[n][m];
+}
+
+/*
+Both engines above keep the whole (n+1) x (m+1) tabulation, but the row-wise independent
+recurrence only ever reads row i-1 when computing row i. So if we only want the length of
+the SCS (and not the SCS itself), we can keep just two rows and swap them after each row,
+which takes the memory from O(n*m) down to O(m) (plus the O(|C|*m) memo A).
+Besides allowing much larger inputs, the two rows are small enough to stay in L2/L3 cache
+instead of streaming the whole tabulation through DRAM.
+
+Note that both the rows and A live on the heap, since for 1M+ chars even A alone
+(26 * (m+1) ints) is way larger than the default stack size.
+*/
+
+// REQUIRES: prev holds row i-1, A_c is the row of memo A for the char X[i-1], 1 <= j
+// EFFECTS: returns tab[i][j] using the row-wise independent recurrence (A_c may be a narrow row
+//          of a reference index, see scs_index.h)
+template <typename Index>
+static inline int rowwise_independent_cell(const Index *A_c, const int *prev, const int i, const int j) {
+    int j_minus_k = A_c[j];
+    int k = j - j_minus_k;
+    int tab_i_j_minus_1;
+    if (j_minus_k == 0)
+        // reached edge of column
+        tab_i_j_minus_1 = i + k - 1;
+    else
+        // found matching symbol
+        tab_i_j_minus_1 = prev[j_minus_k-1] + k;
+    return 1 + MIN(tab_i_j_minus_1, prev[j]);
+}
+
+// buffers for memo A and the 2 rows, they only ever grow so they can be reused across calls
+struct ScsScratch {
+    std::vector<int> A, prev_row, curr_row;
+
+    // EFFECTS: makes sure the buffers are large enough for a string Y of m chars
+    template <typename Alphabet>
+    void reserve(const int m) {
+        if (A.size() < (size_t)Alphabet::SIZE * (m+1))
+            A.resize((size_t)Alphabet::SIZE * (m+1));
+        if (prev_row.size() < (size_t)m + 1) {
+            prev_row.resize(m+1);
+            curr_row.resize(m+1);
+        }
+    }
+};
+
+// REQUIRES: A has Alphabet::SIZE * (m+1) ints, prev and curr m+1 ints each
+// MODIFIES: A, prev, curr
+// EFFECTS: returns the length of SCS using only 2 rows, a team of num_threads threads works on each row
+template <typename Alphabet, typename Seq>
+int scs_rowwise_independent_linear(const Seq &s1, const Seq &s2, int *A, int *prev, int *curr,
+                                   const int num_threads = omp_get_max_threads()) {
+    // get length of both strings
+    const int n = s1.size();
+    const int m = s2.size();
+    // memo A is flattened, i.e. A[c][j] = A[c * (m+1) + j]
+    // only keep 2 rows of tab, i.e. tab[i-1] and tab[i]
+    // Step 1: fill out j-k values in first memo (see paper)
+    compute_j_minus_k<Alphabet>(s2, A);
+
+    // Step 2: use bottom up iteration to find the optimal length of SCS
+    int i = 1;
+#pragma omp parallel num_threads(num_threads)
+{
+    // calculate base case (row 0) first
+#pragma omp for schedule(static)
+    for (int j = 0; j <= m; ++j) {
+        prev[j] = j;
+    }
+    // then iteratively calculate remaining rows
+    while (i <= n) {
+        const int *A_c = &A[(size_t)symbol_idx<Alphabet>(s1, i-1) * (m+1)];
+        // base case (col 0)
+        curr[0] = i;
+#pragma omp for schedule(static)
+        for (int j = 1; j <= m; ++j) {
+            // first find k
+            int j_minus_k = A_c[j];
+            int k = j - j_minus_k;
+            int tab_i_j_minus_1;
+            if (j_minus_k == 0)
+                // reached edge of column
+                tab_i_j_minus_1 = i + k - 1;
+            else
+                // found matching symbol
+                tab_i_j_minus_1 = prev[j_minus_k-1] + k;
+            // compute current value in tab
+            curr[j] = 1 + MIN(tab_i_j_minus_1, prev[j]);
+        }
+        // the implicit barrier of omp for guarantees the whole row is done before the swap
+#pragma omp single
+{
+        std::swap(prev, curr);
+        ++i;
+}
+    }
+}
+    // after the last swap, row n is in prev
+    return prev[m];
+}
+
+// MODIFIES: scratch
+// EFFECTS: same as above, with the buffers in scratch
+template <typename Alphabet, typename Seq>
+int scs_rowwise_independent_linear(const Seq &s1, const Seq &s2, ScsScratch &scratch) {
+    scratch.reserve<Alphabet>(s2.size());
+    return scs_rowwise_independent_linear<Alphabet>(s1, s2, scratch.A.data(), scratch.prev_row.data(), scratch.curr_row.data());
+}
+
+// REQUIRES: A has Alphabet::SIZE * (m+1) ints, prev and curr m+1 ints each
+// MODIFIES: A, prev, curr
+// EFFECTS: same as above, but only the calling thread works on the rows,
+//          i.e. for running many small pairs at the same time (one per thread)
+template <typename Alphabet, typename Seq>
+int scs_rowwise_independent_serial(const Seq &s1, const Seq &s2, int *A, int *prev, int *curr) {
+    // get length of both strings
+    const int n = s1.size();
+    const int m = s2.size();
+    // Step 1: fill out j-k values in first memo
+    for (int c = 0; c < Alphabet::SIZE; ++c) {
+        int *A_c = &A[(size_t)c * (m+1)];
+        A_c[0] = 0;
+        for (int j = 1; j <= m; ++j)
+            A_c[j] = (symbol_idx<Alphabet>(s2, j-1) == c) ? j : A_c[j-1];
+    }
+    // Step 2: use bottom up iteration to find the optimal length of SCS
+    for (int j = 0; j <= m; ++j)
+        prev[j] = j;
+    for (int i = 1; i <= n; ++i) {
+        const int *A_c = &A[(size_t)symbol_idx<Alphabet>(s1, i-1) * (m+1)];
+        curr[0] = i;
+        for (int j = 1; j <= m; ++j)
+            curr[j] = rowwise_independent_cell(A_c, prev, i, j);
+        std::swap(prev, curr);
+    }
+    return prev[m];
+}
+
+// MODIFIES: scratch
+// EFFECTS: same as above, with the buffers in scratch
+template <typename Alphabet, typename Seq>
+int scs_rowwise_independent_serial(const Seq &s1, const Seq &s2, ScsScratch &scratch) {
+    scratch.reserve<Alphabet>(s2.size());
+    return scs_rowwise_independent_serial<Alphabet>(s1, s2, scratch.A.data(), scratch.prev_row.data(), scratch.curr_row.data());
+}
+
+// REQUIRES: diagonals has 3 * (n+1) ints
+// MODIFIES: diagonals
+// EFFECTS: returns the length of SCS with the Anti-diagonal Algorithm (see
+//          parallel_omp_anti_diag_scs.cpp), only keeping the last 3 anti-diagonals, indexed by row,
+//          i.e. O(n) memory no matter how large the alphabet is, with a team of num_threads threads
+template <typename Alphabet, typename Seq>
+int scs_anti_diagonal_rolling(const Seq &s1, const Seq &s2, int *diagonals, const int num_threads = omp_get_max_threads()) {
+    const int n = s1.size();
+    const int m = s2.size();
+    // anti-diagonals d-2, d-1 and d
+    int *before = diagonals;
+    int *last = diagonals + (n+1);
+    int *curr = diagonals + 2 * (n+1);
+#pragma omp parallel num_threads(num_threads)
+{
+    for (int d = 0; d <= n + m; ++d) {
+#pragma omp for schedule(static)
+        for (int a = MAX(0, d - m); a <= MIN(n, d); ++a) {
+            const int b = d - a;
+            if (a == 0)
+                curr[a] = b;
+            else if (b == 0)
+                curr[a] = a;
+            else if (symbol_idx<Alphabet>(s1, a - 1) == symbol_idx<Alphabet>(s2, b - 1))
+                curr[a] = 1 + before[a - 1];
+            else
+                curr[a] = 1 + MIN(last[a], last[a - 1]);
+        }
+#pragma omp single
+{
+        int *oldest = before;
+        before = last;
+        last = curr;
+        curr = oldest;
+}
+    }
+}
+    // anti-diagonal n+m ends up in last
+    return last[n];
+}
+
+template <typename Alphabet, typename Seq>
+int scs_rowwise_independent_linear(const Seq &s1, const Seq &s2) {
+    // allocate memo A and the 2 rows upfront (not part of the execution time)
+    ScsScratch scratch;
+    scratch.reserve<Alphabet>(s2.size());
+    double start, end;
+    // record start time
+    start = omp_get_wtime();
+    const int scs_length = scs_rowwise_independent_linear<Alphabet>(s1, s2, scratch);
+    // record end time
+    end = omp_get_wtime();
+    printf("Execution Time (ms) %f\n", (end - start) * 1000.0);
+    return scs_length;
+}
+
+/*
+Instrumented linear engine.
+Same as the linear engine, but split into 3 phases (memo A, base row, row loop) that each get their
+own time and hardware counters (see scs_perf.h), and each thread records how long it waits in the
+barriers of every row. The implicit barriers of omp for and omp single are replaced by nowait + an
+explicit barrier, which is the same synchronization, so the waits can be timed.
+*/
+
+// MODIFIES: report
+// EFFECTS: returns the length of SCS, with the measurements in report
+template <typename Alphabet, typename Seq>
+int scs_rowwise_independent_instrumented(const Seq &s1, const Seq &s2, PerfReport &report) {
+    // get length of both strings
+    const int n = s1.size();
+    const int m = s2.size();
+    ScsScratch scratch;
+    scratch.reserve<Alphabet>(m);
+    int *A = scratch.A.data();
+    int *prev = scratch.prev_row.data();
+    int *curr = scratch.curr_row.data();
+    // compute_j_minus_k may use more threads than the team of the row loop
+    report.open(MAX(omp_get_max_threads(), MIN(Alphabet::SIZE, omp_get_num_procs())));
+
+    // Phase 1: memo A
+    report.begin_phase("memo_A");
+    compute_j_minus_k<Alphabet>(s2, A);
+    report.end_phase();
+
+    // Phase 2: base case (row 0)
+    report.begin_phase("base_row");
+#pragma omp parallel for schedule(static)
+    for (int j = 0; j <= m; ++j) {
+        prev[j] = j;
+    }
+    report.end_phase();
+
+    // Phase 3: remaining rows
+    report.begin_phase("row_loop");
+    int i = 1;
+#pragma omp parallel
+{
+    const int tid = omp_get_thread_num();
+    double for_wait = 0, single_wait = 0, wait_start;
+    while (i <= n) {
+        const int *A_c = &A[(size_t)symbol_idx<Alphabet>(s1, i-1) * (m+1)];
+        curr[0] = i;
+#pragma omp for schedule(static) nowait
+        for (int j = 1; j <= m; ++j) {
+            curr[j] = rowwise_independent_cell(A_c, prev, i, j);
+        }
+        wait_start = omp_get_wtime();
+#pragma omp barrier
+        for_wait += omp_get_wtime() - wait_start;
+#pragma omp single nowait
+{
+        std::swap(prev, curr);
+        ++i;
+}
+        wait_start = omp_get_wtime();
+#pragma omp barrier
+        single_wait += omp_get_wtime() - wait_start;
+    }
+    report.for_wait_ms[tid] = for_wait * 1000.0;
+    report.single_wait_ms[tid] = single_wait * 1000.0;
+}
+    report.end_phase();
+    // after the last swap, row n is in prev
+    return prev[m];
+}
+
+/*
+Pipelined engine (length only), without any barrier per row.
+The linear engine has every thread wait for every other thread twice per row (omp for + omp single),
+i.e. n full-team barriers. But the lookback tab[i-1][A[c][j]-1] only ever reaches to the left,
+so the thread that owns cols [lo, hi] of row i only needs row i-1 to be done up to col hi.
+Each thread owns one block of cols and goes through all the rows, publishing the last row it has
+finished in its own progress counter (release store, the reader does an acquire load, so the
+values of the row are visible once the counter is). Before computing row i, thread t waits for
+1. all threads to its left to have finished row i-1 (checking only thread t-1 is not enough, it can
+   be a row ahead of the threads to its left)
+2. the rows are kept in a ring of PIPELINE_ROWS_PER_THREAD * num_threads rows, so row i overwrites
+   row i-R, which the threads to the right may still need for row i-R+1. Thus thread t also waits
+   for all threads to its right to have finished row i-R+1.
+Each thread remembers the lowest row the threads on each side have reached, and only reads their
+counters again once it needs a later row, so in a full pipeline (threads to the left a row ahead,
+threads to the right a row behind) it rarely reads them and never waits.
+Thus threads form a wavefront over the rows: thread t starts row 1 after the threads to its left are
+done with row 0, and from then on, they all work at the same time.
+*/
+
+// ring of rows per thread, at least 2 so the pipeline can fill up without waiting on the ring
+#define PIPELINE_ROWS_PER_THREAD 2
+
+// progress counter of one thread, on its own cache line so threads do not share lines when publishing
+struct alignas(64) RowProgress {
+    std::atomic<int> row;
+};
+
+// EFFECTS: waits until the progress of every thread in [lo, hi) has reached row (spins, then yields
+//          once it has waited a while), returns the lowest row they have reached
+static inline int wait_for_rows(const RowProgress *progress, const int lo, const int hi, const int row) {
+    int spins = 0;
+    while (true) {
+        int lowest = INT32_MAX;
+        for (int t = lo; t < hi; ++t)
+            lowest = MIN(lowest, progress[t].row.load(std::memory_order_acquire));
+        if (lowest >= row)
+            return lowest;
+        if (++spins < 1024)
+            _mm_pause();
+        else
+            sched_yield();
+    }
+}
+
+// EFFECTS: returns the block of cols [lo, hi) of thread tid out of cols, each block a multiple of align cols
+static inline void pipeline_block(const int cols, const int tid, const int num_threads, const int align, int &lo, int &hi) {
+    const long long units = (cols + align - 1) / align;
+    lo = MIN(cols, units * tid / num_threads * align);
+    hi = MIN(cols, units * (tid + 1) / num_threads * align);
+}
+
+// EFFECTS: returns the length of SCS, if numa_aware then threads are pinned and each thread's
+//          block of cols is placed on its NUMA node (see scs_numa.h)
+template <typename Alphabet, typename Seq>
+int scs_rowwise_independent_pipelined(const Seq &s1, const Seq &s2, const bool numa_aware = false) {
+    // get length of both strings
+    const int n = s1.size();
+    const int m = s2.size();
+    const int max_threads = omp_get_max_threads();
+    const int num_rows = PIPELINE_ROWS_PER_THREAD * MAX(max_threads, 1);
+    const int page_ints = NUMA_PAGE_BYTES / sizeof(int);
+    // opt: for NUMA, rows are padded to whole pages and blocks are whole pages, so no page is
+    //      shared by 2 threads, as long as every thread still gets at least one page
+    const int stride = numa_aware ? (m + page_ints) / page_ints * page_ints : m + 1;
+    const int align = (numa_aware && m + 1 >= max_threads * page_ints) ? page_ints : 1;
+    // memo A and the ring of rows, row i is at ring[(i % num_rows) * stride],
+    // not touched yet, so the pages go to the node of whichever thread writes them first
+    NumaArray<int> A((size_t)Alphabet::SIZE * stride);
+    NumaArray<int> ring((size_t)num_rows * stride);
+    std::vector<RowProgress> progress(max_threads);
+    // no row is done yet, not even the base case
+    for (RowProgress &p : progress)
+        p.row.store(-1, std::memory_order_relaxed);
+    NumaReport numa;
+    // affinity mask of each thread before it was pinned
+    std::vector<cpu_set_t> saved_affinity(max_threads);
+    if (numa_aware) {
+        // pin the threads and first touch each block (not part of the execution time, same as allocation)
+        const std::vector<std::pair<int, int>> cpus = numa_sorted_cpus();
+        numa.cpu_of_thread.assign(max_threads, -1);
+        numa.node_of_thread.assign(max_threads, -1);
+#pragma omp parallel
+{
+        const int tid = omp_get_thread_num();
+        int lo, hi;
+        pipeline_block(m + 1, tid, omp_get_num_threads(), align, lo, hi);
+        if (!cpus.empty()) {
+            numa.cpu_of_thread[tid] = numa_pin_thread(cpus, tid, saved_affinity[tid]);
+            numa.node_of_thread[tid] = numa_node_of(numa.cpu_of_thread[tid]);
+        }
+        for (int c = 0; c < Alphabet::SIZE; ++c)
+            memset(&A[(size_t)c * stride + lo], 0, (hi - lo) * sizeof(int));
+        for (int r = 0; r < num_rows; ++r)
+            memset(&ring[(size_t)r * stride + lo], 0, (hi - lo) * sizeof(int));
+}
+    }
+    double start, end;
+    // record start time
+    start = omp_get_wtime();
+    // Step 1: fill out j-k values in first memo (see paper)
+    compute_j_minus_k<Alphabet>(s2, A.data(), stride);
+
+    // Step 2: every thread goes through all the rows for its own block of cols
+#pragma omp parallel
+{
+    const int tid = omp_get_thread_num();
+    const int num_threads = omp_get_num_threads();
+    // block of cols [lo, hi)
+    int lo, hi;
+    pipeline_block(m + 1, tid, num_threads, align, lo, hi);
+    // base case (row 0)
+    for (int j = lo; j < hi; ++j)
+        ring[j] = j;
+    progress[tid].row.store(0, std::memory_order_release);
+    // lowest row known to be done by all threads to the left/right
+    int left_done = (tid > 0) ? -1 : n;
+    int right_done = (tid < num_threads - 1) ? -1 : n;
+    for (int i = 1; i <= n; ++i) {
+        // row i-1 must be done up to col hi
+        if (left_done < i-1)
+            left_done = wait_for_rows(progress.data(), 0, tid, i-1);
+        // row i-num_rows must no longer be needed by the threads to the right
+        if (i >= num_rows && right_done < i - num_rows + 1)
+            right_done = wait_for_rows(progress.data(), tid + 1, num_threads, i - num_rows + 1);
+        const int *A_c = &A[(size_t)symbol_idx<Alphabet>(s1, i-1) * stride];
+        const int *prev = &ring[(size_t)((i-1) % num_rows) * stride];
+        int *curr = &ring[(size_t)(i % num_rows) * stride];
+        int j = lo;
+        if (j == 0 && hi > 0) {
+            // base case (col 0)
+            curr[0] = i;
+            ++j;
+        }
+        for (; j < hi; ++j)
+            curr[j] = rowwise_independent_cell(A_c, prev, i, j);
+        progress[tid].row.store(i, std::memory_order_release);
+    }
+}
+    const int scs_length = ring[(size_t)(n % num_rows) * stride + m];
+    // record end time
+    end = omp_get_wtime();
+    printf("Execution Time (ms) %f\n", (end - start) * 1000.0);
+    if (numa_aware) {
+        // unpin the threads (the same team as above), so later regions of the caller run anywhere again
+#pragma omp parallel
+{
+        const int tid = omp_get_thread_num();
+        if (tid < max_threads && numa.cpu_of_thread[tid] >= 0)
+            numa_unpin_thread(saved_affinity[tid]);
+}
+        // where the block of each thread ended up
+        for (int tid = 0; tid < max_threads; ++tid) {
+            int lo, hi;
+            pipeline_block(m + 1, tid, max_threads, align, lo, hi);
+            for (int c = 0; c < Alphabet::SIZE; ++c)
+                numa_count_pages(&A[(size_t)c * stride + lo], (hi - lo) * sizeof(int), numa.node_of_thread[tid], numa.local_pages, numa.remote_pages);
+            for (int r = 0; r < num_rows; ++r)
+                numa_count_pages(&ring[(size_t)r * stride + lo], (hi - lo) * sizeof(int), numa.node_of_thread[tid], numa.local_pages, numa.remote_pages);
+        }
+        numa.print();
+    }
+    return scs_length;
+}
+
+/*
+All the engines above only give the length of the SCS. To also get the SCS itself in linear
+memory, we use Hirschberg's divide and conquer idea on top of the row-wise independent recurrence.
+
+Any path through tab from [0][0] to [n][m] has to cross row mid = n/2 at some column k, so
+    SCS(X, Y) = MIN over k of { SCS(X[0, mid), Y[0, k)) + SCS(X[mid, n), Y[k, m)) }
+The first term for every k is simply row mid of tab, i.e. a forward pass.
+The second term for every k is the last row of the tabulation of the reversed strings
+(i.e. a reverse pass), since SCS(X[mid, n), Y[k, m)) = SCS(rev(X[mid, n)), rev(Y)[0, m-k)).
+Both passes only need 2 rows + memo A, and they are independent of each other.
+
+After finding the best k, the two halves are again independent sub-problems, and since we
+know the length of the left half (row mid at col k), we know exactly where each half has to
+write into the output buffer, so both halves can run as parallel tasks and write directly
+into a buffer that is allocated once upfront.
+Small sub-problems simply fall back to the full tabulation + traceback (see SCS_bottom_up).
+*/
+
+// sub-problems with at most this many cells are solved with the full tabulation
+#define HIRSCHBERG_BASE_CELLS (1 << 18)
+// rows with at least this many cols are split into tasks in the forward/reverse passes
+#define HIRSCHBERG_PARALLEL_COLS (1 << 14)
+#define HIRSCHBERG_COLS_PER_TASK (1 << 12)
+
+// REQUIRES: x and y point to the index (in Alphabet) of the first char to use,
+//           dir = 1 (forward) or -1 (reverse), i.e. the ith char of X is x[i * dir],
+//           last_row has m+1 entries
+// MODIFIES: last_row
+// EFFECTS: computes the last row (row n) of tab of X and Y, using 2 rows + memo A
+template <typename Alphabet>
+static void scs_last_row(const uint8_t *x, const int n, const uint8_t *y, const int m,
+                         const int dir, int *last_row) {
+    // memo A for (this part of) Y, flattened
+    std::vector<int> A((size_t)Alphabet::SIZE * (m+1));
+    for (int c = 0; c < Alphabet::SIZE; ++c) {
+        int *A_c = &A[(size_t)c * (m+1)];
+        A_c[0] = 0;
+        for (int j = 1; j <= m; ++j)
+            A_c[j] = (y[(j-1) * dir] == c) ? j : A_c[j-1];
+    }
+    std::vector<int> other_row(m+1);
+    int *prev = last_row;
+    int *curr = other_row.data();
+    // base case (row 0)
+    for (int j = 0; j <= m; ++j)
+        prev[j] = j;
+    for (int i = 1; i <= n; ++i) {
+        const int *A_c = &A[(size_t)x[(i-1) * dir] * (m+1)];
+        // base case (col 0)
+        curr[0] = i;
+        if (m >= HIRSCHBERG_PARALLEL_COLS) {
+            // taskloop waits for all of its tasks, i.e. the whole row is done afterwards
+#pragma omp taskloop grainsize(HIRSCHBERG_COLS_PER_TASK) firstprivate(A_c, prev, curr, i)
+            for (int j = 1; j <= m; ++j)
+                curr[j] = rowwise_independent_cell(A_c, prev, i, j);
+        }
+        else {
+            for (int j = 1; j <= m; ++j)
+                curr[j] = rowwise_independent_cell(A_c, prev, i, j);
+        }
+        std::swap(prev, curr);
+    }
+    // row n ends up in prev, which is not necessarily last_row
+    if (prev != last_row)
+        std::copy(prev, prev + m + 1, last_row);
+}
+
+// REQUIRES: x and y hold the indices (in the alphabet) of the chars
+// MODIFIES: out
+// EFFECTS: writes SCS of X, Y (n, m chars) into out using the full tabulation and
+//          returns its length
+static int scs_full_table(const uint8_t *x, const int n, const uint8_t *y, const int m, char *out) {
+    std::vector<int> tab((n+1) * (m+1));
+    // tab[i][j] = tab[i * (m+1) + j]
+    for (int i = 0; i <= n; ++i) {
+        for (int j = 0; j <= m; ++j) {
+            if (i == 0)
+                tab[j] = j;
+            else if (j == 0)
+                tab[i * (m+1)] = i;
+            else if (x[i-1] == y[j-1])
+                tab[i * (m+1) + j] = 1 + tab[(i-1) * (m+1) + j-1];
+            else
+                tab[i * (m+1) + j] = 1 + MIN(tab[i * (m+1) + j-1], tab[(i-1) * (m+1) + j]);
+        }
+    }
+    // traceback, same as SCS_bottom_up in serial_scs.cpp
+    const int length = tab[n * (m+1) + m];
+    int idx_to_write = length - 1;
+    int i = n, j = m;
+    while (i > 0 && j > 0) {
+        if (x[i-1] == y[j-1]) {
+            out[idx_to_write--] = x[i-1];
+            --i;
+            --j;
+        }
+        else if (tab[i * (m+1) + j-1] < tab[(i-1) * (m+1) + j]) {
+            out[idx_to_write--] = y[j-1];
+            --j;
+        }
+        else {
+            out[idx_to_write--] = x[i-1];
+            --i;
+        }
+    }
+    while (j > 0) {
+        out[idx_to_write--] = y[j-1];
+        --j;
+    }
+    while (i > 0) {
+        out[idx_to_write--] = x[i-1];
+        --i;
+    }
+    return length;
+}
+
+// REQUIRES: x and y hold the indices (in Alphabet) of the chars
+// MODIFIES: out
+// EFFECTS: writes SCS of X, Y (n, m chars) into out using Hirschberg's approach and
+//          returns its length, must be called inside a parallel region
+template <typename Alphabet>
+static int scs_hirschberg_rec(const uint8_t *x, const int n, const uint8_t *y, const int m, char *out) {
+    // base case: one of the strings is empty
+    if (n == 0) {
+        std::copy(y, y + m, out);
+        return m;
+    }
+    if (m == 0) {
+        std::copy(x, x + n, out);
+        return n;
+    }
+    // base case: only one char in X, it either matches the first occurrence in Y or goes first
+    if (n == 1) {
+        const uint8_t *match = std::find(y, y + m, x[0]);
+        if (match != y + m) {
+            std::copy(y, y + m, out);
+            return m;
+        }
+        out[0] = x[0];
+        std::copy(y, y + m, out + 1);
+        return m + 1;
+    }
+    // base case: sub-problem is small enough for the full tabulation
+    if ((long long)(n+1) * (m+1) <= HIRSCHBERG_BASE_CELLS)
+        return scs_full_table(x, n, y, m, out);
+
+    const int mid = n / 2;
+    int split_col, left_length, right_length;
+    {
+        // forward[k] = SCS(X[0, mid), Y[0, k)), reverse[m-k] = SCS(X[mid, n), Y[k, m))
+        std::vector<int> forward(m+1), reverse(m+1);
+        int *fwd = forward.data();
+        int *rev = reverse.data();
+#pragma omp task shared(x, y) firstprivate(fwd)
+        scs_last_row<Alphabet>(x, mid, y, m, 1, fwd);
+#pragma omp task shared(x, y) firstprivate(rev)
+        scs_last_row<Alphabet>(x + n - 1, n - mid, y + m - 1, m, -1, rev);
+#pragma omp taskwait
+        // find the col where the optimal path crosses row mid
+        split_col = 0;
+        for (int k = 1; k <= m; ++k) {
+            if (fwd[k] + rev[m-k] < fwd[split_col] + rev[m-split_col])
+                split_col = k;
+        }
+        left_length = fwd[split_col];
+    }
+    // both halves write into disjoint parts of out
+#pragma omp task shared(right_length)
+    right_length = scs_hirschberg_rec<Alphabet>(x + mid, n - mid, y + split_col, m - split_col, out + left_length);
+    scs_hirschberg_rec<Alphabet>(x, mid, y, split_col, out);
+#pragma omp taskwait
+    return left_length + right_length;
+}
+
+// EFFECTS: returns the SCS of X and Y using Hirschberg's approach (with a team of num_threads threads)
+template <typename Alphabet, typename Seq>
+std::string find_scs_hirschberg(const Seq &s1, const Seq &s2, const int num_threads = omp_get_max_threads()) {
+    // get length of both strings
+    const int n = s1.size();
+    const int m = s2.size();
+    // the recursion works on the indices of the chars (1 byte each), so X and Y can be
+    // read backwards and sliced cheaply regardless of how they are stored
+    std::vector<uint8_t> x(n), y(m);
+    for (int i = 0; i < n; ++i)
+        x[i] = symbol_idx<Alphabet>(s1, i);
+    for (int j = 0; j < m; ++j)
+        y[j] = symbol_idx<Alphabet>(s2, j);
+    // preallocate output, SCS is at most n + m chars
+    std::string scs(n + m, ' ');
+    int length;
+#pragma omp parallel num_threads(num_threads)
+{
+#pragma omp single
+    length = scs_hirschberg_rec<Alphabet>(x.data(), n, y.data(), m, &scs[0]);
+}
+    scs.resize(length);
+    // convert indices back to chars
+    for (char &letter : scs)
+        letter = Alphabet::symbol((uint8_t)letter);
+    return scs;
+}
+
+template <typename Alphabet, typename Seq>
+std::string scs_hirschberg(const Seq &s1, const Seq &s2) {
+    double start, end;
+    // record start time
+    start = omp_get_wtime();
+    std::string scs = find_scs_hirschberg<Alphabet>(s1, s2);
+    // record end time
+    end = omp_get_wtime();
+    printf("Execution Time (ms) %f\n", (end - start) * 1000.0);
+    return scs;
+}
+
+/*
+Banded engine (length only).
+Same band of diagonals as serial_scs banded (see scs_band.h), but with the row-wise independent
+recurrence, i.e. the cols of the band of each row are split among the threads.
+Cells left of the band of row i-1 are treated as infinite, so a cell whose j-k (A[c][j]) points left
+of the band does not use it. The col right of the band of row i-1 (which the last col of the band of
+row i reads) is filled in as if the path went right along the row, i.e. tab[i-1][hi] + 1. These are
+lengths of actual paths, so the result is never shorter than the SCS, and never longer than the
+shortest path inside the band, which is all the doubling needs (see scs_band.h).
+Memo A is computed once for all passes.
+*/
+
+// REQUIRES: A is memo A of s2 (A[c][j] = A[c * (m+1) + j]),
+//           max_length < 0 (no limit) or band contains every path of length at most max_length
+// EFFECTS: returns the length of the shortest path inside band (see above), using 2 rows,
+//          BAND_INFINITY if it stopped early bc no path can be at most max_length long
+template <typename Alphabet, typename Seq>
+int scs_rowwise_independent_band(const Seq &s1, const Seq &s2, const int *A, const ScsBand &band, const long long max_length) {
+    const int n = s1.size();
+    const int m = s2.size();
+    // 1 extra col, for the col right of the band
+    std::vector<int> prev_row(m+2), curr_row(m+2);
+    int *prev = prev_row.data();
+    int *curr = curr_row.data();
+    // base case (row 0)
+    for (int j = 0; j <= band.hi(0) + 1; ++j)
+        prev[j] = j;
+    bool stopped = false;
+    int i = 1;
+    long long lowest;
+#pragma omp parallel
+{
+    while (i <= n && !stopped) {
+        const int *A_c = &A[(size_t)symbol_idx<Alphabet>(s1, i-1) * (m+1)];
+        const int lo = band.lo(i);
+        const int hi = band.hi(i);
+        // first col of the band of the previous row
+        const int prev_lo = band.lo(i-1);
+#pragma omp single
+        lowest = BAND_INFINITY;
+        // lowest length any path through this row can still have
+#pragma omp for schedule(static) reduction(min: lowest)
+        for (int j = lo; j <= hi; ++j) {
+            if (j == 0) {
+                // base case (col 0)
+                curr[j] = i;
+            }
+            else {
+                const int j_minus_k = A_c[j];
+                int tab_i_j_minus_1;
+                if (j_minus_k == 0)
+                    // reached edge of column
+                    tab_i_j_minus_1 = i + j - 1;
+                else if (j_minus_k - 1 >= prev_lo)
+                    // found matching symbol
+                    tab_i_j_minus_1 = prev[j_minus_k-1] + (j - j_minus_k);
+                else
+                    // matching symbol is left of the band
+                    tab_i_j_minus_1 = BAND_INFINITY;
+                curr[j] = 1 + MIN(tab_i_j_minus_1, prev[j]);
+            }
+            lowest = MIN(lowest, (long long)curr[j] + MAX(n - i, m - j));
+        }
+#pragma omp single
+{
+        // the col right of the band, as if the path went right along the row
+        curr[hi + 1] = curr[hi] + 1;
+        if (max_length >= 0 && lowest > max_length)
+            stopped = true;
+        std::swap(prev, curr);
+        ++i;
+}
+    }
+}
+    return stopped ? BAND_INFINITY : prev[m];
+}
+
+// EFFECTS: returns the length of SCS, computing the band of diagonals with doubling width until it
+//          is optimal, or if max_length >= 0, whether it is at most max_length (at_most) and the length
+//          only if it is (otherwise -1)
+template <typename Alphabet, typename Seq>
+int scs_rowwise_independent_banded(const Seq &s1, const Seq &s2, const long long max_length, bool &at_most) {
+    const int n = s1.size();
+    const int m = s2.size();
+    std::vector<int> A((size_t)Alphabet::SIZE * (m+1));
+    double start, end;
+    // record start time
+    start = omp_get_wtime();
+    // Step 1: fill out j-k values in first memo (see paper)
+    compute_j_minus_k<Alphabet>(s2, A.data());
+    // Step 2: bands of doubling width, or the one band for max_length
+    int length = -1;
+    if (max_length >= 0) {
+        const long long d = ScsBand::width_for(n, m, max_length);
+        const int band_length = (d >= 0) ? scs_rowwise_independent_band<Alphabet>(s1, s2, A.data(), {n, m, d}, max_length) : BAND_INFINITY;
+        at_most = band_length <= max_length;
+        // only paths of length at most max_length are guaranteed to be in the band
+        if (at_most)
+            length = band_length;
+    }
+    else {
+        ScsBand band = {n, m, BAND_INITIAL_WIDTH};
+        int passes = 0;
+        while (true) {
+            length = scs_rowwise_independent_band<Alphabet>(s1, s2, A.data(), band, -1);
+            ++passes;
+            if (band.is_optimal(length))
+                break;
+            band.d *= 2;
+        }
+        printf("Band Width %lld, Passes %d\n", band.d, passes);
+    }
+    // record end time
+    end = omp_get_wtime();
+    printf("Execution Time (ms) %f\n", (end - start) * 1000.0);
+    return length;
+}
+
+/*
+Four-Russians engine (length only, alphabets of at most 4 symbols).
+As the no_branch engine relies on, the differences between adjacent cells of tab are 0 or 1, both
+along a row (tab[i][j] - tab[i][j-1]) and along a col (tab[i][j] - tab[i-1][j]). So the bottom row and
+right col of a t x t block of tab, relative to its top left corner, only depend on
+    the t chars of X and of Y of the block, the t differences along the top and along the left
+and there are only (|C|^t)^2 * 2^t * 2^t of those. For DNA and t = 3 that is 2^18, so the
+differences along the bottom and right of every possible block (6 bits) fit in a 256 KB table, which
+is built upfront (in parallel, each entry is independent) and stays in L2 cache.
+Then tab is swept t x t cells at a time, with one table lookup per block: a block only needs the
+differences along the bottom of the block above it and the right of the block to its left, so blocks
+on the same anti-diagonal (of blocks) are independent and run in parallel, same as the Anti-diagonal
+Algorithm. The blocks at the bottom and right edge that are cut short (n, m not multiples of t) are
+computed cell by cell instead.
+Finally, tab[n][m] = tab[n][0] + sum of the differences along row n = n + (number of 1s).
+This is n * m / t^2 lookups instead of n * m cells. (The O(n * m / log(n)) bound comes from growing t
+with log n, here t is fixed so the table stays in cache.)
+*/
+
+// block size, and bits of a symbol in the table index, i.e. at most 4 symbols
+#define FOUR_RUSSIANS_T 3
+#define FOUR_RUSSIANS_SYMBOL_BITS 2
+// bits of the table index: X block, Y block, top and left differences
+#define FOUR_RUSSIANS_KEY_BITS (2 * FOUR_RUSSIANS_T * FOUR_RUSSIANS_SYMBOL_BITS + 2 * FOUR_RUSSIANS_T)
+
+// REQUIRES: 0 < rows, cols <= FOUR_RUSSIANS_T, bit p of left is tab[p+1][0] - tab[p][0],
+//           bit q of top is tab[0][q+1] - tab[0][q] of the block
+// MODIFIES: bottom, right
+// EFFECTS: computes the differences along the bottom row and right col of the block (same layout)
+static inline void four_russians_block(const uint8_t *x, const int rows, const uint8_t *y, const int cols,
+                                       const unsigned top, const unsigned left, unsigned &bottom, unsigned &right) {
+    // current row of the block, relative to its top left corner
+    int row[FOUR_RUSSIANS_T + 1];
+    row[0] = 0;
+    for (int q = 0; q < cols; ++q)
+        row[q+1] = row[q] + ((top >> q) & 1);
+    right = 0;
+    for (int p = 0; p < rows; ++p) {
+        const int above_right = row[cols];
+        int diag = row[0];
+        row[0] += (left >> p) & 1;
+        for (int q = 0; q < cols; ++q) {
+            const int up = row[q+1];
+            row[q+1] = (x[p] == y[q]) ? 1 + diag : 1 + MIN(row[q], up);
+            diag = up;
+        }
+        right |= unsigned(row[cols] - above_right) << p;
+    }
+    bottom = 0;
+    for (int q = 0; q < cols; ++q)
+        bottom |= unsigned(row[q+1] - row[q]) << q;
+}
+
+// REQUIRES: Alphabet::SIZE <= 1 << FOUR_RUSSIANS_SYMBOL_BITS
+// EFFECTS: returns the length of SCS using the block lookup table
+template <typename Alphabet, typename Seq>
+int scs_four_russians(const Seq &s1, const Seq &s2) {
+    static_assert(Alphabet::SIZE <= (1 << FOUR_RUSSIANS_SYMBOL_BITS), "four_russians needs at most 4 symbols");
+    const int T = FOUR_RUSSIANS_T;
+    const int n = s1.size();
+    const int m = s2.size();
+    // number of blocks, the last ones may be cut short
+    const int row_blocks = (n + T - 1) / T;
+    const int col_blocks = (m + T - 1) / T;
+    std::vector<uint8_t> table((size_t)1 << FOUR_RUSSIANS_KEY_BITS);
+    // symbols of X and Y, and the symbols of each block packed into its part of the table index
+    std::vector<uint8_t> x(n), y(m);
+    std::vector<unsigned> x_key(row_blocks), y_key(col_blocks);
+    // differences along the bottom of the last block of each col of blocks, and the right of each row
+    std::vector<uint8_t> bottom(col_blocks), right(row_blocks);
+    double start, end, table_end;
+    // record start time
+    start = omp_get_wtime();
+    // Step 1: build the table, one entry per possible block
+#pragma omp parallel for schedule(static)
+    for (int key = 0; key < (1 << FOUR_RUSSIANS_KEY_BITS); ++key) {
+        uint8_t bx[T], by[T];
+        for (int p = 0; p < T; ++p) {
+            bx[p] = (key >> (4 * T + FOUR_RUSSIANS_SYMBOL_BITS * p)) & ((1 << FOUR_RUSSIANS_SYMBOL_BITS) - 1);
+            by[p] = (key >> (2 * T + FOUR_RUSSIANS_SYMBOL_BITS * p)) & ((1 << FOUR_RUSSIANS_SYMBOL_BITS) - 1);
+        }
+        unsigned block_bottom, block_right;
+        four_russians_block(bx, T, by, T, (key >> T) & ((1 << T) - 1), key & ((1 << T) - 1), block_bottom, block_right);
+        table[key] = block_bottom | (block_right << T);
+    }
+    table_end = omp_get_wtime();
+    // Step 2: keys of the blocks of X and Y, and the first row and col of tab (differences of 1)
+#pragma omp parallel
+{
+#pragma omp for schedule(static) nowait
+    for (int i = 0; i < n; ++i)
+        x[i] = symbol_idx<Alphabet>(s1, i);
+#pragma omp for schedule(static)
+    for (int j = 0; j < m; ++j)
+        y[j] = symbol_idx<Alphabet>(s2, j);
+#pragma omp for schedule(static) nowait
+    for (int bi = 0; bi < row_blocks; ++bi) {
+        x_key[bi] = 0;
+        for (int p = 0; p < T && bi * T + p < n; ++p)
+            x_key[bi] |= x[bi * T + p] << (FOUR_RUSSIANS_SYMBOL_BITS * p);
+        right[bi] = (1 << MIN(T, n - bi * T)) - 1;
+    }
+#pragma omp for schedule(static)
+    for (int bj = 0; bj < col_blocks; ++bj) {
+        y_key[bj] = 0;
+        for (int q = 0; q < T && bj * T + q < m; ++q)
+            y_key[bj] |= y[bj * T + q] << (FOUR_RUSSIANS_SYMBOL_BITS * q);
+        bottom[bj] = (1 << MIN(T, m - bj * T)) - 1;
+    }
+    // Step 3: sweep the anti-diagonals of blocks
+    for (int d = 0; d < row_blocks + col_blocks - 1; ++d) {
+        const int bi_lo = MAX(0, d - col_blocks + 1);
+        const int bi_hi = MIN(d, row_blocks - 1);
+#pragma omp for schedule(static)
+        for (int bi = bi_lo; bi <= bi_hi; ++bi) {
+            const int bj = d - bi;
+            const int rows = MIN(T, n - bi * T);
+            const int cols = MIN(T, m - bj * T);
+            if (rows == T && cols == T) {
+                const unsigned key = (x_key[bi] << (4 * T)) | (y_key[bj] << (2 * T)) | (bottom[bj] << T) | right[bi];
+                bottom[bj] = table[key] & ((1 << T) - 1);
+                right[bi] = table[key] >> T;
+            }
+            else {
+                // block cut short at the edge
+                unsigned block_bottom, block_right;
+                four_russians_block(&x[bi * T], rows, &y[bj * T], cols, bottom[bj], right[bi], block_bottom, block_right);
+                bottom[bj] = block_bottom;
+                right[bi] = block_right;
+            }
+        }
+    }
+}
+    // tab[n][m] = tab[n][0] + differences along row n
+    int scs_length = n;
+    for (int bj = 0; bj < col_blocks; ++bj)
+        scs_length += __builtin_popcount(bottom[bj]);
+    // record end time
+    end = omp_get_wtime();
+    printf("Table Time (ms) %f\n", (table_end - start) * 1000.0);
+    printf("Execution Time (ms) %f\n", (end - start) * 1000.0);
+    return scs_length;
+}
+
+/*
+Checkpointed engine (finds the SCS itself).
+Jobs have a time limit, and a long run that hits it loses everything. So this engine is the linear
+engine (2 rows) that also writes every interval-th row, interval = ceil(sqrt(n)), into a checkpoint
+file (see scs_checkpoint.h). When it is run again on the same inputs, it resumes from the last
+checkpointed row instead of row 0.
+
+The same checkpoints also give the SCS itself with O(m * sqrt(n)) memory instead of the O(n * m) of
+the full tabulation: the traceback goes from tab[n][m] up to row 0, and only ever needs the rows of
+the block of rows it is in. So the rows of one block at a time (at most interval+1 rows) are recomputed
+from the checkpoint at the top of the block, and the traceback goes through that block, then the one
+above it, and so on. Every row is computed twice in total (once forward, once in the traceback),
+compared to O(n * m * log(n)) cells for Hirschberg, and the checkpoint file takes
+O(m * sqrt(n)) ints on disk.
+*/
+
+// EFFECTS: returns the SCS of X and Y, checkpointing rows into the file at path (resuming from it if
+//          it has checkpoints of the same X and Y), resumed_row is the row it resumed from (0 if none)
+template <typename Alphabet, typename Seq>
+std::string scs_rowwise_independent_checkpointed(const Seq &s1, const Seq &s2, const std::string &path, int &resumed_row) {
+    // get length of both strings
+    const int n = s1.size();
+    const int m = s2.size();
+    int interval = 1;
+    while ((long long)interval * interval < n)
+        ++interval;
+    CheckpointHeader expected = {};
+    expected.alphabet_size = Alphabet::SIZE;
+    expected.n = n;
+    expected.m = m;
+    expected.interval = interval;
+    expected.input_hash = sequence_hash<Alphabet>(s2, sequence_hash<Alphabet>(s1) ^ ((uint64_t)n << 32));
+    CheckpointFile checkpoints;
+    if (!checkpoints.open(path, expected)) {
+        printf("Error: Could not open checkpoint file: %s\n", path.c_str());
+        exit(1);
+    }
+    std::vector<int> A((size_t)Alphabet::SIZE * (m+1));
+    std::vector<int> prev_row(m+1), curr_row(m+1);
+    int *prev = prev_row.data();
+    int *curr = curr_row.data();
+    // Step 1: fill out j-k values in first memo (see paper)
+    compute_j_minus_k<Alphabet>(s2, A.data());
+
+    // Step 2: forward pass from the last checkpoint (or the base case), checkpointing along the way
+    if (checkpoints.has_rows()) {
+        resumed_row = checkpoints.last_row();
+        std::copy(checkpoints.row(resumed_row), checkpoints.row(resumed_row) + m + 1, prev);
+    }
+    else {
+        resumed_row = 0;
+        for (int j = 0; j <= m; ++j)
+            prev[j] = j;
+        std::copy(prev, prev + m + 1, checkpoints.row(0));
+        checkpoints.commit(0);
+    }
+    int i = resumed_row + 1;
+#pragma omp parallel
+{
+    while (i <= n) {
+        const int *A_c = &A[(size_t)symbol_idx<Alphabet>(s1, i-1) * (m+1)];
+        // base case (col 0)
+        curr[0] = i;
+#pragma omp for schedule(static)
+        for (int j = 1; j <= m; ++j)
+            curr[j] = rowwise_independent_cell(A_c, prev, i, j);
+#pragma omp single
+{
+        std::swap(prev, curr);
+        if (i % interval == 0) {
+            std::copy(prev, prev + m + 1, checkpoints.row(i));
+            checkpoints.commit(i);
+        }
+        ++i;
+}
+    }
+}
+    const int length = prev[m];
+
+    // Step 3: traceback one block of rows at a time, bottom up
+    std::string scs(length, ' ');
+    int idx_to_write = length - 1;
+    // tab of the rows [top, i] of the current block, tab[r][j] = block[(r - top) * (m+1) + j]
+    std::vector<int> block((size_t)(interval + 1) * (m+1));
+    int j = m;
+    i = n;
+    while (i > 0 && j > 0) {
+        const int top = (i - 1) / interval * interval;
+        std::copy(checkpoints.row(top), checkpoints.row(top) + m + 1, block.begin());
+        // recompute the rows of the block from its checkpoint
+#pragma omp parallel
+{
+        for (int r = top + 1; r <= i; ++r) {
+            const int *A_c = &A[(size_t)symbol_idx<Alphabet>(s1, r-1) * (m+1)];
+            const int *above = &block[(size_t)(r - 1 - top) * (m+1)];
+            int *row = &block[(size_t)(r - top) * (m+1)];
+            row[0] = r;
+#pragma omp for schedule(static)
+            for (int col = 1; col <= m; ++col)
+                row[col] = rowwise_independent_cell(A_c, above, r, col);
+        }
+}
+        // traceback, same as SCS_bottom_up in serial_scs.cpp, until the top of the block
+        while (i > top && j > 0) {
+            const int *row = &block[(size_t)(i - top) * (m+1)];
+            const int *above = &block[(size_t)(i - 1 - top) * (m+1)];
+            const int x = symbol_idx<Alphabet>(s1, i-1);
+            const int y = symbol_idx<Alphabet>(s2, j-1);
+            if (x == y) {
+                scs[idx_to_write--] = Alphabet::symbol(x);
+                --i;
+                --j;
+            }
+            else if (row[j-1] < above[j]) {
+                scs[idx_to_write--] = Alphabet::symbol(y);
+                --j;
+            }
+            else {
+                scs[idx_to_write--] = Alphabet::symbol(x);
+                --i;
+            }
+        }
+    }
+    while (j > 0) {
+        scs[idx_to_write--] = Alphabet::symbol(symbol_idx<Alphabet>(s2, j-1));
+        --j;
+    }
+    while (i > 0) {
+        scs[idx_to_write--] = Alphabet::symbol(symbol_idx<Alphabet>(s1, i-1));
+        --i;
+    }
+    return scs;
+}
+
+template <typename Alphabet, typename Seq>
+std::string scs_rowwise_independent_checkpointed(const Seq &s1, const Seq &s2, const std::string &path) {
+    double start, end;
+    int resumed_row;
+    // record start time
+    start = omp_get_wtime();
+    std::string scs = scs_rowwise_independent_checkpointed<Alphabet>(s1, s2, path, resumed_row);
+    // record end time
+    end = omp_get_wtime();
+    printf("Execution Time (ms) %f\n", (end - start) * 1000.0);
+    printf("Checkpoint File: %s, Resumed From Row %d\n", path.c_str(), resumed_row);
+    return scs;
+}
+
+/*
+Bit-parallel engine (length only).
+Since |SCS(X, Y)| = n + m - |LCS(X, Y)|, we can instead compute the LCS length with the
+bit-vector LCS recurrence (Allison-Dix / Hyyro), which handles 64 cols of a row per instruction.
+
+Similar to memo A, we precompute a match mask for every char c in the alphabet C:
+    M[c] bit j-1 is set iff Y[j-1] = C[c]
+Then we keep one bit vector V of m bits for the current row, where bit j-1 of V is 0 iff
+the LCS of row i increases at col j (i.e. the same 0/1 differences between adjacent cols
+that the no_branch engine relies on, just for LCS instead of SCS). Starting with all 1s,
+each row is computed from the previous row as
+    U = V & M[X[i-1]]
+    V = (V + U) | (V & ~M[X[i-1]])
+and after the last row, |LCS| is the number of 0 bits in V.
+
+For m > 64, V is split into 64-bit words and the carry of the addition has to be propagated
+from the lowest to the highest word. Since this carry chain is sequential within a row,
+wider SIMD registers do not help here (there is no 256/512-bit add with carry), so we stay
+with 64-bit words, which already packs 64 cells into each add instead of one cell per int.
+*/
+
+#define WORD_BITS 64
+
+// REQUIRES: M has Alphabet::SIZE * num_words words of 0s, V has num_words words of 1s
+//           (num_words = ceil(m / 64))
+// MODIFIES: M, V
+// EFFECTS: returns the length of SCS with the bit-vector LCS recurrence
+template <typename Alphabet, typename Seq>
+int scs_bit_parallel(const Seq &s1, const Seq &s2, uint64_t *M, uint64_t *V) {
+    // get length of both strings
+    const int n = s1.size();
+    const int m = s2.size();
+    // number of 64-bit words per row
+    const int num_words = (m + WORD_BITS - 1) / WORD_BITS;
+    // Step 1: fill out match masks, one thread for each letter (same as memo A)
+#pragma omp parallel for num_threads(MIN(Alphabet::SIZE, omp_get_num_procs()))
+    for (int c = 0; c < Alphabet::SIZE; ++c) {
+        uint64_t *M_c = &M[c * num_words];
+        for (int j = 0; j < m; ++j) {
+            if (symbol_idx<Alphabet>(s2, j) == c)
+                M_c[j / WORD_BITS] |= uint64_t(1) << (j % WORD_BITS);
+        }
+    }
+
+    // Step 2: compute rows 64 cols at a time
+    uint64_t *v = V;
+    if (num_words == 1) {
+        // opt: no carry to propagate when Y fits in a single word
+        uint64_t v0 = v[0];
+        for (int i = 0; i < n; ++i) {
+            const uint64_t match = M[symbol_idx<Alphabet>(s1, i)];
+            v0 = (v0 + (v0 & match)) | (v0 & ~match);
+        }
+        v[0] = v0;
+    }
+    else {
+        for (int i = 0; i < n; ++i) {
+            const uint64_t *M_c = &M[symbol_idx<Alphabet>(s1, i) * num_words];
+            uint64_t carry = 0;
+            for (int w = 0; w < num_words; ++w) {
+                const uint64_t v_w = v[w];
+                const uint64_t match = M_c[w];
+                // add with carry in and carry out
+                uint64_t sum = v_w + (v_w & match);
+                uint64_t carry_out = sum < v_w;
+                sum += carry;
+                carry_out |= sum < carry;
+                carry = carry_out;
+                v[w] = sum | (v_w & ~match);
+            }
+        }
+    }
+    // Step 3: count the 0 bits in V (only the lowest m bits are part of the row)
+    int lcs_length = 0;
+    for (int w = 0; w < num_words; ++w) {
+        uint64_t zeros = ~v[w];
+        if (w == num_words - 1 && m % WORD_BITS != 0)
+            zeros &= (uint64_t(1) << (m % WORD_BITS)) - 1;
+        lcs_length += __builtin_popcountll(zeros);
+    }
+    // |SCS| = n + m - |LCS|
+    return n + m - lcs_length;
+}
+
+template <typename Alphabet, typename Seq>
+int scs_bit_parallel(const Seq &s1, const Seq &s2) {
+    const int num_words = (s2.size() + WORD_BITS - 1) / WORD_BITS;
+    // match masks, flattened, i.e. M[c][w] = M[c * num_words + w]
+    std::vector<uint64_t> M(Alphabet::SIZE * num_words, 0);
+    // current row, all 1s initially
+    std::vector<uint64_t> V(num_words, ~uint64_t(0));
+    double start, end;
+    // record start time
+    start = omp_get_wtime();
+    const int scs_length = scs_bit_parallel<Alphabet>(s1, s2, M.data(), V.data());
+    // record end time
+    end = omp_get_wtime();
+    printf("Execution Time (ms) %f\n", (end - start) * 1000.0);
+    return scs_length;
+}
+
+/*
+SIMD engine (length only).
+The inner loop of the no_branch engine reads A[c][j], tab[i-1][j] and tab[i-1][A[c][j]-1],
+the last one being an indirect load that stops the compiler from vectorizing the loop.
+Here the row kernel is vectorized by hand: the indirect loads become a gather, and the
+boolean logic of no_branch becomes compares + blends, processing 8 (AVX2) or 16 (AVX-512)
+cols per instruction. Rows are kept in 2 buffers like the linear engine.
+
+The kernel is chosen at runtime based on what the CPU supports, with the plain scalar kernel
+as the fallback. Before it is used, the chosen kernel is checked against the scalar kernel
+on a small test row, and if they do not agree we fall back to the scalar kernel.
+*/
+
+// number of cols each thread takes at a time (multiple of 16 so blocks stay aligned to vectors)
+#define SIMD_COLS_PER_BLOCK 1024
+
+// REQUIRES: prev holds row i-1, A_c is the row of memo A for the char X[i-1], 1 <= j_begin
+// MODIFIES: curr
+// EFFECTS: computes tab[i][j] for j in [j_begin, j_end) into curr
+typedef void (*row_kernel_t)(const int *A_c, const int *prev, int *curr, int i, int j_begin, int j_end);
+
+static void row_kernel_scalar(const int *A_c, const int *prev, int *curr, int i, int j_begin, int j_end) {
+    for (int j = j_begin; j < j_end; ++j) {
+        int j_minus_k = A_c[j];
+        // same as no_branch
+        bool found_matching = j_minus_k > 0;
+        int tab_i_j_minus_1 = found_matching ? prev[j_minus_k-1] + (j - j_minus_k) : i + j - 1;
+        curr[j] = prev[j] + (prev[j] <= tab_i_j_minus_1);
+    }
+}
+
+__attribute__((target("avx2")))
+static void row_kernel_avx2(const int *A_c, const int *prev, int *curr, int i, int j_begin, int j_end) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    int j = j_begin;
+    for (; j + 8 <= j_end; j += 8) {
+        const __m256i j_vec = _mm256_add_epi32(_mm256_set1_epi32(j), lane);
+        const __m256i j_minus_k = _mm256_loadu_si256((const __m256i *)(A_c + j));
+        const __m256i up = _mm256_loadu_si256((const __m256i *)(prev + j));
+        // lanes that found a matching symbol, only these are gathered
+        const __m256i found_matching = _mm256_cmpgt_epi32(j_minus_k, zero);
+        const __m256i gather_idx = _mm256_max_epi32(_mm256_sub_epi32(j_minus_k, one), zero);
+        const __m256i gathered = _mm256_mask_i32gather_epi32(zero, prev, gather_idx, found_matching, 4);
+        // tab[i][j-1] = tab[i-1][j-k-1] + k   or   i + j - 1
+        const __m256i if_found = _mm256_add_epi32(gathered, _mm256_sub_epi32(j_vec, j_minus_k));
+        const __m256i if_edge = _mm256_add_epi32(_mm256_set1_epi32(i - 1), j_vec);
+        const __m256i tab_i_j_minus_1 = _mm256_blendv_epi8(if_edge, if_found, found_matching);
+        // add 1 iff tab[i-1][j] <= tab[i][j-1], i.e. not tab[i-1][j] > tab[i][j-1]
+        const __m256i greater = _mm256_cmpgt_epi32(up, tab_i_j_minus_1);
+        _mm256_storeu_si256((__m256i *)(curr + j), _mm256_add_epi32(up, _mm256_andnot_si256(greater, one)));
+    }
+    // remaining cols
+    row_kernel_scalar(A_c, prev, curr, i, j, j_end);
+}
+
+__attribute__((target("avx512f")))
+static void row_kernel_avx512(const int *A_c, const int *prev, int *curr, int i, int j_begin, int j_end) {
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i one = _mm512_set1_epi32(1);
+    const __m512i lane = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    int j = j_begin;
+    for (; j + 16 <= j_end; j += 16) {
+        const __m512i j_vec = _mm512_add_epi32(_mm512_set1_epi32(j), lane);
+        const __m512i j_minus_k = _mm512_loadu_si512(A_c + j);
+        const __m512i up = _mm512_loadu_si512(prev + j);
+        // lanes that found a matching symbol, only these are gathered
+        const __mmask16 found_matching = _mm512_cmpgt_epi32_mask(j_minus_k, zero);
+        const __m512i gathered = _mm512_mask_i32gather_epi32(zero, found_matching,
+                                                              _mm512_sub_epi32(j_minus_k, one), prev, 4);
+        // tab[i][j-1] = tab[i-1][j-k-1] + k   or   i + j - 1
+        const __m512i if_found = _mm512_add_epi32(gathered, _mm512_sub_epi32(j_vec, j_minus_k));
+        const __m512i if_edge = _mm512_add_epi32(_mm512_set1_epi32(i - 1), j_vec);
+        const __m512i tab_i_j_minus_1 = _mm512_mask_blend_epi32(found_matching, if_edge, if_found);
+        // add 1 iff tab[i-1][j] <= tab[i][j-1]
+        const __mmask16 leq = _mm512_cmple_epi32_mask(up, tab_i_j_minus_1);
+        _mm512_storeu_si512(curr + j, _mm512_mask_add_epi32(up, leq, up, one));
+    }
+    // remaining cols
+    row_kernel_scalar(A_c, prev, curr, i, j, j_end);
+}
+
+// EFFECTS: returns true if kernel gives the same rows as the scalar kernel on a small test input
+static bool row_kernel_matches_scalar(row_kernel_t kernel) {
+    // test strings, long enough to go through both the vector loop and the remaining cols
+    const std::string x = "thequickbrownfoxjumpsoverthelazydog";
+    const std::string y = "packmyboxwithfivedozenliquorjugsandthensome";
+    const int m = y.size();
+    std::vector<int> A(LowercaseAlphabet::SIZE * (m+1));
+    compute_j_minus_k<LowercaseAlphabet>(y, A.data());
+    std::vector<int> prev(m+1), expected(m+1), actual(m+1);
+    for (int j = 0; j <= m; ++j)
+        prev[j] = j;
+    for (int i = 1; i <= (int)x.size(); ++i) {
+        const int *A_c = &A[LowercaseAlphabet::to_idx(x[i-1]) * (m+1)];
+        expected[0] = actual[0] = i;
+        row_kernel_scalar(A_c, prev.data(), expected.data(), i, 1, m+1);
+        kernel(A_c, prev.data(), actual.data(), i, 1, m+1);
+        if (expected != actual)
+            return false;
+        prev = expected;
+    }
+    return true;
+}
+
+// EFFECTS: returns the fastest of the avx512, avx2 and scalar variants of a kernel that the CPU
+//          supports and that passes matches_scalar(variant), warns about the ones that do not pass
+template <typename Kernel, typename Check>
+static Kernel select_kernel(Kernel avx512, Kernel avx2, Kernel scalar, Check matches_scalar,
+                            const char *kind, const char *&kernel_name) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        if (matches_scalar(avx512)) {
+            kernel_name = "avx512";
+            return avx512;
+        }
+        printf("Warning: avx512 %s kernel does not match scalar %s kernel\n", kind, kind);
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        if (matches_scalar(avx2)) {
+            kernel_name = "avx2";
+            return avx2;
+        }
+        printf("Warning: avx2 %s kernel does not match scalar %s kernel\n", kind, kind);
+    }
+    kernel_name = "scalar";
+    return scalar;
+}
+
+// EFFECTS: returns the fastest row kernel supported by the CPU that passes the check
+static row_kernel_t select_row_kernel(const char *&kernel_name) {
+    return select_kernel<row_kernel_t>(row_kernel_avx512, row_kernel_avx2, row_kernel_scalar,
+                                       row_kernel_matches_scalar, "row", kernel_name);
+}
+
+template <typename Alphabet, typename Seq>
+int scs_rowwise_independent_simd(const Seq &s1, const Seq &s2) {
+    // get length of both strings
+    const int n = s1.size();
+    const int m = s2.size();
+    // pick the row kernel once
+    const char *kernel_name;
+    const row_kernel_t row_kernel = select_row_kernel(kernel_name);
+    printf("Row kernel: %s\n", kernel_name);
+    // create memoization, A is flattened, i.e. A[c][j] = A[c * (m+1) + j]
+    std::vector<int> A((size_t)Alphabet::SIZE * (m+1));
+    // only keep 2 rows of tab, i.e. tab[i-1] and tab[i]
+    std::vector<int> prev_row(m+1), curr_row(m+1);
+    int *prev = prev_row.data();
+    int *curr = curr_row.data();
+    const int num_blocks = m / SIMD_COLS_PER_BLOCK + 1;
+    double start, end;
+    // record start time
+    start = omp_get_wtime();
+    // Step 1: fill out j-k values in first memo (see paper)
+    compute_j_minus_k<Alphabet>(s2, A.data());
+
+    // Step 2: use bottom up iteration to find the optimal length of SCS
+    int i = 1;
+#pragma omp parallel
+{
+    // calculate base case (row 0) first
+#pragma omp for schedule(static)
+    for (int j = 0; j <= m; ++j) {
+        prev[j] = j;
+    }
+    // then iteratively calculate remaining rows
+    while (i <= n) {
+        const int *A_c = &A[(size_t)symbol_idx<Alphabet>(s1, i-1) * (m+1)];
+        // base case (col 0)
+        curr[0] = i;
+        // each thread computes whole blocks of cols with the row kernel
+#pragma omp for schedule(static)
+        for (int b = 0; b < num_blocks; ++b) {
+            const int j_begin = MAX(1, b * SIMD_COLS_PER_BLOCK);
+            const int j_end = MIN(m + 1, (b + 1) * SIMD_COLS_PER_BLOCK);
+            row_kernel(A_c, prev, curr, i, j_begin, j_end);
+        }
+#pragma omp single
+{
+        std::swap(prev, curr);
+        ++i;
+}
+    }
+}
+    // record end time
+    end = omp_get_wtime();
+    printf("Execution Time (ms) %f\n", (end - start) * 1000.0);
+    // after the last swap, row n is in prev
+    return prev[m];
+}
+
+/*
+Narrow engine: the linear engine with 16-bit cells.
+Every cell of tab (and memo A) is a 32-bit int, but neighbouring cells are close: adjacent cells of a
+row differ by at most 1, and tab[i][j] - tab[i-1][j] is 0 or 1. So each row is split into blocks of
+NARROW_BLOCK_COLS cols, and a block is stored as one 32-bit base (the value of its first col) and a
+16-bit offset from the base per cell, which is at most NARROW_BLOCK_COLS in size. Memo A is stored as
+the 16-bit distance k = j - A[c][j] to the last occurrence of c, capped at NARROW_BLOCK_COLS.
+That halves the bytes of the rows and of memo A that every row streams through.
+
+Row i, block of cols [J, J+W) with base nb = tab[i][J]:
+- col J is computed in 32 bits with the row-wise independent recurrence, from the last occurrence
+  of c = X[i-1] at or before J (a small 32-bit table with one entry per block and letter).
+- for the other cols j, with p = j - k the last occurrence of c:
+  if p-1 is in the block (k <= j-1-J): tab[i][j-1] = tab[i-1][p-1] + k, all offsets in the block
+  otherwise: tab[i][j-1] = tab[i][J] + (j-1-J), since along a row tab goes up by 1 per col
+             from the last occurrence of c (or from col 0) to col j-1 (see parallel_mpi_scs.cpp)
+  and tab[i-1][j] = its offset + (base of row i-1 - nb), where the difference is 0 or -1.
+So only the first col of each block is computed in 32 bits, and the result is exactly the same as
+the int engines. The other cols use the row kernel of the simd engine on 16-bit offsets (widened to
+32-bit lanes in registers, since gathers are 32-bit, and narrowed again on the store), so it is the
+bytes read and written per cell that are halved, not the number of cols per instruction.
+The blocks of a row are split between threads, like the linear engine.
+*/
+
+// cols per block of the narrow engine, offsets are within +-2 * NARROW_BLOCK_COLS
+#define NARROW_BLOCK_COLS 2048
+
+// REQUIRES: prev holds the offsets of row i-1 of the block starting at col J, K_c the distances of
+//           memo A for the char X[i-1], delta = base of row i-1 - base of row i, J < j_begin
+// MODIFIES: curr
+// EFFECTS: computes the offsets of tab[i][j] for j in [j_begin, j_end) into curr
+typedef void (*narrow_kernel_t)(const uint16_t *K_c, const int16_t *prev, int16_t *curr, int J, int delta, int j_begin, int j_end);
+
+static void narrow_kernel_scalar(const uint16_t *__restrict__ K_c, const int16_t *__restrict__ prev, int16_t *__restrict__ curr,
+                                 int J, int delta, int j_begin, int j_end) {
+    for (int j = j_begin; j < j_end; ++j) {
+        const int k = K_c[j];
+        const int in_block = j - 1 - J;
+        // tab[i][j-1] and tab[i-1][j], both relative to the base of row i-1
+        const int left = (k <= in_block) ? prev[j-k-1] + k : in_block - delta;
+        const int up = prev[j];
+        curr[j] = MIN(left, up) + 1 + delta;
+    }
+}
+
+__attribute__((target("avx2")))
+static void narrow_kernel_avx2(const uint16_t *K_c, const int16_t *prev, int16_t *curr, int J, int delta, int j_begin, int j_end) {
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i delta_vec = _mm256_set1_epi32(delta);
+    const __m256i one_plus_delta = _mm256_set1_epi32(1 + delta);
+    int j = j_begin;
+    for (; j + 8 <= j_end; j += 8) {
+        const __m256i j_vec = _mm256_add_epi32(_mm256_set1_epi32(j), lane);
+        // widen 8 offsets and distances to 32 bits
+        const __m256i k = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(K_c + j)));
+        const __m256i up = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(prev + j)));
+        const __m256i in_block = _mm256_sub_epi32(j_vec, _mm256_set1_epi32(J + 1));
+        // lanes whose last occurrence is in the block, only these are gathered
+        const __m256i found = _mm256_xor_si256(_mm256_cmpgt_epi32(k, in_block), _mm256_set1_epi32(-1));
+        const __m256i gather_idx = _mm256_sub_epi32(_mm256_sub_epi32(j_vec, k), one);
+        // 32 bits at each 16-bit offset, the low half is the offset
+        __m256i gathered = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), (const int *)prev, gather_idx, found, 2);
+        gathered = _mm256_srai_epi32(_mm256_slli_epi32(gathered, 16), 16);
+        const __m256i left = _mm256_blendv_epi8(_mm256_sub_epi32(in_block, delta_vec), _mm256_add_epi32(gathered, k), found);
+        const __m256i result = _mm256_add_epi32(_mm256_min_epi32(left, up), one_plus_delta);
+        // narrow back to 16 bits, packs works within 128-bit halves
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(result, result), 0x08);
+        _mm_storeu_si128((__m128i *)(curr + j), _mm256_castsi256_si128(packed));
+    }
+    // remaining cols
+    narrow_kernel_scalar(K_c, prev, curr, J, delta, j, j_end);
+}
+
+__attribute__((target("avx512f")))
+static void narrow_kernel_avx512(const uint16_t *K_c, const int16_t *prev, int16_t *curr, int J, int delta, int j_begin, int j_end) {
+    const __m512i one = _mm512_set1_epi32(1);
+    const __m512i lane = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m512i delta_vec = _mm512_set1_epi32(delta);
+    const __m512i one_plus_delta = _mm512_set1_epi32(1 + delta);
+    int j = j_begin;
+    for (; j + 16 <= j_end; j += 16) {
+        const __m512i j_vec = _mm512_add_epi32(_mm512_set1_epi32(j), lane);
+        // widen 16 offsets and distances to 32 bits
+        const __m512i k = _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i *)(K_c + j)));
+        const __m512i up = _mm512_cvtepi16_epi32(_mm256_loadu_si256((const __m256i *)(prev + j)));
+        const __m512i in_block = _mm512_sub_epi32(j_vec, _mm512_set1_epi32(J + 1));
+        // lanes whose last occurrence is in the block, only these are gathered
+        const __mmask16 found = _mm512_cmple_epi32_mask(k, in_block);
+        const __m512i gather_idx = _mm512_sub_epi32(_mm512_sub_epi32(j_vec, k), one);
+        // 32 bits at each 16-bit offset, the low half is the offset
+        __m512i gathered = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), found, gather_idx, prev, 2);
+        gathered = _mm512_srai_epi32(_mm512_slli_epi32(gathered, 16), 16);
+        const __m512i left = _mm512_mask_blend_epi32(found, _mm512_sub_epi32(in_block, delta_vec), _mm512_add_epi32(gathered, k));
+        const __m512i result = _mm512_add_epi32(_mm512_min_epi32(left, up), one_plus_delta);
+        // narrow back to 16 bits
+        _mm256_storeu_si256((__m256i *)(curr + j), _mm512_cvtepi32_epi16(result));
+    }
+    // remaining cols
+    narrow_kernel_scalar(K_c, prev, curr, J, delta, j, j_end);
+}
+
+// EFFECTS: returns true if kernel gives the same offsets as the scalar kernel on a test input of
+//          3 blocks, with rows of tab from the scalar row kernel
+static bool narrow_kernel_matches_scalar(narrow_kernel_t kernel) {
+    // Y over a, b, c, d only, so the other chars of X are never found (capped distances), and
+    // last occurrences fall both in the block and in the block before
+    const int n = 40;
+    const int m = 2 * NARROW_BLOCK_COLS + 45;
+    std::string x(n, ' '), y(m, ' ');
+    unsigned int seed = 1;
+    for (int i = 0; i < n; ++i) {
+        seed = seed * 1103515245 + 12345;
+        x[i] = 'a' + (seed >> 16) % LowercaseAlphabet::SIZE;
+    }
+    for (int j = 0; j < m; ++j) {
+        seed = seed * 1103515245 + 12345;
+        y[j] = 'a' + (seed >> 16) % 4;
+    }
+    std::vector<int> A(LowercaseAlphabet::SIZE * (m+1));
+    compute_j_minus_k<LowercaseAlphabet>(y, A.data());
+    std::vector<uint16_t> K(LowercaseAlphabet::SIZE * (m+1));
+    for (int c = 0; c < LowercaseAlphabet::SIZE; ++c) {
+        for (int j = 0; j <= m; ++j) {
+            const int last = A[c * (m+1) + j];
+            K[c * (m+1) + j] = (last > 0 && j - last < NARROW_BLOCK_COLS) ? j - last : NARROW_BLOCK_COLS;
+        }
+    }
+    // 32-bit rows of tab, and the offsets of one block (+1 so the gathers never read past the end)
+    std::vector<int> prev(m+1), curr(m+1);
+    std::vector<int16_t> block_prev(m+2), expected(m+2), actual(m+2);
+    for (int j = 0; j <= m; ++j)
+        prev[j] = j;
+    for (int i = 1; i <= n; ++i) {
+        const int c = LowercaseAlphabet::to_idx(x[i-1]);
+        curr[0] = i;
+        row_kernel_scalar(&A[c * (m+1)], prev.data(), curr.data(), i, 1, m+1);
+        for (int J = 1; J <= m; J += NARROW_BLOCK_COLS) {
+            const int j_end = MIN(J + NARROW_BLOCK_COLS, m + 1);
+            for (int j = J; j < j_end; ++j)
+                block_prev[j] = prev[j] - prev[J];
+            expected[J] = actual[J] = 0;
+            narrow_kernel_scalar(&K[c * (m+1)], block_prev.data(), expected.data(), J, prev[J] - curr[J], J + 1, j_end);
+            kernel(&K[c * (m+1)], block_prev.data(), actual.data(), J, prev[J] - curr[J], J + 1, j_end);
+            if (!std::equal(&expected[J], &expected[J] + (j_end - J), &actual[J]))
+                return false;
+        }
+        std::swap(prev, curr);
+    }
+    return true;
+}
+
+// EFFECTS: returns the fastest narrow kernel supported by the CPU that passes the check
+static narrow_kernel_t select_narrow_kernel(const char *&kernel_name) {
+    return select_kernel<narrow_kernel_t>(narrow_kernel_avx512, narrow_kernel_avx2, narrow_kernel_scalar,
+                                          narrow_kernel_matches_scalar, "narrow", kernel_name);
+}
+
+template <typename Alphabet, typename Seq>
+int scs_rowwise_independent_narrow(const Seq &s1, const Seq &s2) {
+    // get length of both strings
+    const int n = s1.size();
+    const int m = s2.size();
+    if (m == 0)
+        return n;
+    // pick the row kernel once
+    const char *kernel_name;
+    const narrow_kernel_t narrow_kernel = select_narrow_kernel(kernel_name);
+    printf("Row kernel: %s\n", kernel_name);
+    const int num_blocks = (m + NARROW_BLOCK_COLS - 1) / NARROW_BLOCK_COLS;
+    // allocate memo A, the 2 rows and their bases upfront (not part of the execution time)
+    // distance to the last occurrence, K[c][j] = K[c * (m+1) + j]
+    std::vector<uint16_t> K((size_t)Alphabet::SIZE * (m+1));
+    // A[c][J] of the first col J of each block, A_start[c][b] = A_start[c * num_blocks + b]
+    std::vector<int> A_start((size_t)Alphabet::SIZE * num_blocks);
+    // offsets of cols 1 to m (col 0 is always i, +1 so the gathers never read past the end),
+    // and the base of each block
+    std::vector<int16_t> prev_row(m+2), curr_row(m+2);
+    std::vector<int> prev_bases(num_blocks), curr_bases(num_blocks);
+    int16_t *prev = prev_row.data();
+    int16_t *curr = curr_row.data();
+    int *prev_base = prev_bases.data();
+    int *curr_base = curr_bases.data();
+    double start, end;
+    // record start time
+    start = omp_get_wtime();
+#pragma omp parallel
+{
+    // Step 1: memo A as distances, and as positions at the first col of each block
+#pragma omp for schedule(static)
+    for (int c = 0; c < Alphabet::SIZE; ++c) {
+        uint16_t *K_c = &K[(size_t)c * (m+1)];
+        int last = 0;
+        K_c[0] = NARROW_BLOCK_COLS;
+        for (int j = 1; j <= m; ++j) {
+            if (symbol_idx<Alphabet>(s2, j-1) == c)
+                last = j;
+            K_c[j] = (last > 0 && j - last < NARROW_BLOCK_COLS) ? j - last : NARROW_BLOCK_COLS;
+            if ((j - 1) % NARROW_BLOCK_COLS == 0)
+                A_start[(size_t)c * num_blocks + (j - 1) / NARROW_BLOCK_COLS] = last;
+        }
+    }
+    // base case (row 0), tab[0][j] = j
+#pragma omp for schedule(static)
+    for (int b = 0; b < num_blocks; ++b) {
+        const int J = b * NARROW_BLOCK_COLS + 1;
+        prev_base[b] = J;
+        for (int j = J; j <= MIN(J + NARROW_BLOCK_COLS - 1, m); ++j)
+            prev[j] = j - J;
+    }
+    // Step 2: rows, the blocks of each row split between threads
+    for (int i = 1; i <= n; ++i) {
+        const int c = symbol_idx<Alphabet>(s1, i-1);
+        const uint16_t *K_c = &K[(size_t)c * (m+1)];
+        const int *A_start_c = &A_start[(size_t)c * num_blocks];
+#pragma omp for schedule(static)
+        for (int b = 0; b < num_blocks; ++b) {
+            const int J = b * NARROW_BLOCK_COLS + 1;
+            // col J in 32 bits, tab[i-1][q] = base of its block + offset (or i-1 for col 0)
+            const int p = A_start_c[b];
+            int tab_i_J_minus_1;
+            if (p == 0)
+                tab_i_J_minus_1 = i + J - 1;
+            else if (p == 1)
+                tab_i_J_minus_1 = (i - 1) + (J - p);
+            else
+                tab_i_J_minus_1 = prev_base[(p - 2) / NARROW_BLOCK_COLS] + prev[p-1] + (J - p);
+            curr_base[b] = 1 + MIN(tab_i_J_minus_1, prev_base[b]);
+            curr[J] = 0;
+            // the other cols in 16 bits
+            narrow_kernel(K_c, prev, curr, J, prev_base[b] - curr_base[b], J + 1, MIN(J + NARROW_BLOCK_COLS, m + 1));
+        }
+#pragma omp single
+{
+        std::swap(prev, curr);
+        std::swap(prev_base, curr_base);
+}
+    }
+}
+    // record end time
+    end = omp_get_wtime();
+    printf("Execution Time (ms) %f\n", (end - start) * 1000.0);
+    // row n is in prev
+    return prev_base[(m - 1) / NARROW_BLOCK_COLS] + prev[m];
+}
+
+/*
+Bit-compressed tabulation (SCS itself, not just the length).
+As observed in the no_branch engine, tab[i][j] - tab[i-1][j] is always either 0 or 1.
+So instead of the whole tabulation of ints, we only store these differences as 1 bit per cell,
+packed into 64-bit words (bit j-1 of row i is tab[i][j] - tab[i-1][j]), with the leftmost
+column tab[i][0] = i as the anchor that does not need to be stored. This is 32x smaller than
+the tabulation of ints, e.g. ~1.25 GB for 100000 * 100000.
+
+It turns out the differences alone are enough for the traceback, without recovering any tab value:
+- if X[i-1] = Y[j-1], move diagonally like before
+- otherwise tab[i][j] = 1 + MIN(tab[i][j-1], tab[i-1][j]), so
+    - if the bit is 1, tab[i-1][j] = tab[i][j] - 1 is the minimum, move up
+    - if the bit is 0, tab[i-1][j] = tab[i][j] is not the minimum, so it has to be tab[i][j-1], move left
+The rows themselves are computed with 2 rows of ints and the row kernel of the simd engine.
+*/
+
+template <typename Alphabet, typename Seq>
+std::string scs_bit_table(const Seq &s1, const Seq &s2) {
+    // get length of both strings
+    const int n = s1.size();
+    const int m = s2.size();
+    // pick the row kernel once
+    const char *kernel_name;
+    const row_kernel_t row_kernel = select_row_kernel(kernel_name);
+    printf("Row kernel: %s\n", kernel_name);
+    // number of 64-bit words per row
+    const int num_words = (m + WORD_BITS - 1) / WORD_BITS;
+    // bits of rows 1 to n, flattened, i.e. row i word w is bits[(i-1) * num_words + w]
+    std::vector<uint64_t> bits((long long)n * num_words);
+    // create memoization, A is flattened, i.e. A[c][j] = A[c * (m+1) + j]
+    std::vector<int> A((size_t)Alphabet::SIZE * (m+1));
+    // only keep 2 rows of ints, i.e. tab[i-1] and tab[i]
+    std::vector<int> prev_row(m+1), curr_row(m+1);
+    int *prev = prev_row.data();
+    int *curr = curr_row.data();
+    double start, end;
+    // record start time
+    start = omp_get_wtime();
+    // Step 1: fill out j-k values in first memo (see paper)
+    compute_j_minus_k<Alphabet>(s2, A.data());
+
+    // Step 2: compute the rows and keep only the differences
+    int i = 1;
+#pragma omp parallel
+{
+    // calculate base case (row 0) first
+#pragma omp for schedule(static)
+    for (int j = 0; j <= m; ++j) {
+        prev[j] = j;
+    }
+    while (i <= n) {
+        const int *A_c = &A[(size_t)symbol_idx<Alphabet>(s1, i-1) * (m+1)];
+        uint64_t *bits_i = &bits[(long long)(i-1) * num_words];
+        // base case (col 0)
+        curr[0] = i;
+        // each thread computes whole words, so no 2 threads write to the same word
+#pragma omp for schedule(static)
+        for (int w = 0; w < num_words; ++w) {
+            const int j_begin = w * WORD_BITS + 1;
+            const int j_end = MIN(m + 1, j_begin + WORD_BITS);
+            row_kernel(A_c, prev, curr, i, j_begin, j_end);
+            uint64_t word = 0;
+            for (int j = j_begin; j < j_end; ++j)
+                word |= uint64_t(curr[j] - prev[j]) << (j - j_begin);
+            bits_i[w] = word;
+        }
+#pragma omp single
+{
+        std::swap(prev, curr);
+        ++i;
+}
+    }
+}
+    // Step 3: traceback using only the bits, from the last cell
+    const int length = prev[m];
+    std::string scs(length, ' ');
+    int idx_to_write = length - 1;
+    int row = n, col = m;
+    while (row > 0 && col > 0) {
+        if (symbol_idx<Alphabet>(s1, row-1) == symbol_idx<Alphabet>(s2, col-1)) {
+            scs[idx_to_write--] = Alphabet::symbol(symbol_idx<Alphabet>(s1, row-1));
+            --row;
+            --col;
+        }
+        else if ((bits[(long long)(row-1) * num_words + (col-1) / WORD_BITS] >> ((col-1) % WORD_BITS)) & 1) {
+            scs[idx_to_write--] = Alphabet::symbol(symbol_idx<Alphabet>(s1, row-1));
+            --row;
+        }
+        else {
+            scs[idx_to_write--] = Alphabet::symbol(symbol_idx<Alphabet>(s2, col-1));
+            --col;
+        }
+    }
+    while (col > 0) {
+        scs[idx_to_write--] = Alphabet::symbol(symbol_idx<Alphabet>(s2, col-1));
+        --col;
+    }
+    while (row > 0) {
+        scs[idx_to_write--] = Alphabet::symbol(symbol_idx<Alphabet>(s1, row-1));
+        --row;
+    }
+    // record end time
+    end = omp_get_wtime();
+    printf("Execution Time (ms) %f\n", (end - start) * 1000.0);
+    return scs;
+}
+
+/*
+One-vs-many engine (length only), i.e. one query string against many (short) target strings.
+For short targets a single row is too short to be worth splitting across threads or vectorizing,
+so instead we put STRIPE_LANES different targets into the lanes of a vector and compute one row
+of each of them in lockstep (inter-sequence SIMD).
+
+Since SCS(X, Y) = SCS(Y, X), we let the query be the string along the cols, so memo A only depends
+on the query and is shared by every lane, and each target is the string along the rows, i.e. each
+lane only needs its own current char and row index. The 2 rows of all lanes are interleaved,
+i.e. tab[i][j] of lane l is at row[j * STRIPE_LANES + l], so for a fixed j the cells of all lanes
+are contiguous, and the 2 lookups that depend on the lane (A[c][j] and tab[i-1][A[c][j]-1])
+become gathers.
+
+Targets have different lengths, so each lane keeps its own row index: as soon as a lane has
+finished its last row, its result is recorded and the lane is refilled with the next target
+(resetting that lane to row 0). Lanes left without a target keep computing a dummy row that
+is simply ignored. Each thread runs its own set of lanes, and all threads take targets from
+a shared counter, which also balances the work between threads.
+The vector kernels gather with 32-bit indices, so they are only used while memo A and the
+interleaved rows have fewer than 2^31 ints, otherwise the scalar kernel is used.
+*/
+
+// the AVX-512 kernel holds all lanes in one vector, and both vector kernels use
+// j * STRIPE_LANES = j << 4 when computing gather indices
+#define STRIPE_LANES 16
+
+// REQUIRES: prev and curr hold rows of STRIPE_LANES lanes (interleaved), A_offset[l] = c * (m+1)
+//           where c is the current char of lane l, row[l] is the current row index of lane l
+// MODIFIES: curr
+// EFFECTS: computes cols [1, m] of the current row of every lane
+typedef void (*stripe_kernel_t)(const int *A, const int *prev, int *curr, const ptrdiff_t *A_offset,
+                                const int *row, int m);
+
+static void stripe_kernel_scalar(const int *A, const int *prev, int *curr, const ptrdiff_t *A_offset,
+                                 const int *row, int m) {
+    for (int j = 1; j <= m; ++j) {
+        const int *up = prev + (size_t)j * STRIPE_LANES;
+        for (int l = 0; l < STRIPE_LANES; ++l) {
+            int j_minus_k = A[A_offset[l] + j];
+            // same as no_branch
+            int tab_i_j_minus_1 = (j_minus_k > 0) ? prev[(size_t)(j_minus_k-1) * STRIPE_LANES + l] + (j - j_minus_k)
+                                                  : row[l] + j - 1;
+            curr[(size_t)j * STRIPE_LANES + l] = up[l] + (up[l] <= tab_i_j_minus_1);
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+static void stripe_kernel_avx2(const int *A, const int *prev, int *curr, const ptrdiff_t *A_offset,
+                               const int *row, int m) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi32(1);
+    // offsets as 32-bit gather indices (see stripe_kernel_fits_int)
+    int offset32[STRIPE_LANES];
+    for (int l = 0; l < STRIPE_LANES; ++l)
+        offset32[l] = A_offset[l];
+    // 2 halves of 8 lanes each
+    for (int half = 0; half < STRIPE_LANES; half += 8) {
+        const __m256i lane = _mm256_setr_epi32(half, half + 1, half + 2, half + 3, half + 4, half + 5, half + 6, half + 7);
+        const __m256i offset = _mm256_loadu_si256((const __m256i *)(offset32 + half));
+        const __m256i row_minus_1 = _mm256_sub_epi32(_mm256_loadu_si256((const __m256i *)(row + half)), one);
+        for (int j = 1; j <= m; ++j) {
+            const __m256i j_vec = _mm256_set1_epi32(j);
+            const __m256i j_minus_k = _mm256_i32gather_epi32(A, _mm256_add_epi32(offset, j_vec), 4);
+            const __m256i up = _mm256_loadu_si256((const __m256i *)(prev + j * STRIPE_LANES + half));
+            const __m256i found_matching = _mm256_cmpgt_epi32(j_minus_k, zero);
+            // index of tab[i-1][j-k-1] of each lane
+            const __m256i gather_idx = _mm256_add_epi32(_mm256_slli_epi32(_mm256_max_epi32(_mm256_sub_epi32(j_minus_k, one), zero), 4), lane);
+            const __m256i gathered = _mm256_mask_i32gather_epi32(zero, prev, gather_idx, found_matching, 4);
+            const __m256i if_found = _mm256_add_epi32(gathered, _mm256_sub_epi32(j_vec, j_minus_k));
+            const __m256i if_edge = _mm256_add_epi32(row_minus_1, j_vec);
+            const __m256i tab_i_j_minus_1 = _mm256_blendv_epi8(if_edge, if_found, found_matching);
+            const __m256i greater = _mm256_cmpgt_epi32(up, tab_i_j_minus_1);
+            _mm256_storeu_si256((__m256i *)(curr + j * STRIPE_LANES + half), _mm256_add_epi32(up, _mm256_andnot_si256(greater, one)));
+        }
+    }
+}
+
+__attribute__((target("avx512f")))
+static void stripe_kernel_avx512(const int *A, const int *prev, int *curr, const ptrdiff_t *A_offset,
+                                 const int *row, int m) {
+    // offsets as 32-bit gather indices (see stripe_kernel_fits_int)
+    int offset32[STRIPE_LANES];
+    for (int l = 0; l < STRIPE_LANES; ++l)
+        offset32[l] = A_offset[l];
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i one = _mm512_set1_epi32(1);
+    const __m512i lane = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m512i offset = _mm512_loadu_si512(offset32);
+    const __m512i row_minus_1 = _mm512_sub_epi32(_mm512_loadu_si512(row), one);
+    for (int j = 1; j <= m; ++j) {
+        const __m512i j_vec = _mm512_set1_epi32(j);
+        const __m512i j_minus_k = _mm512_i32gather_epi32(_mm512_add_epi32(offset, j_vec), A, 4);
+        const __m512i up = _mm512_loadu_si512(prev + j * STRIPE_LANES);
+        const __mmask16 found_matching = _mm512_cmpgt_epi32_mask(j_minus_k, zero);
+        // index of tab[i-1][j-k-1] of each lane
+        const __m512i gather_idx = _mm512_add_epi32(_mm512_slli_epi32(_mm512_sub_epi32(j_minus_k, one), 4), lane);
+        const __m512i gathered = _mm512_mask_i32gather_epi32(zero, found_matching, gather_idx, prev, 4);
+        const __m512i if_found = _mm512_add_epi32(gathered, _mm512_sub_epi32(j_vec, j_minus_k));
+        const __m512i if_edge = _mm512_add_epi32(row_minus_1, j_vec);
+        const __m512i tab_i_j_minus_1 = _mm512_mask_blend_epi32(found_matching, if_edge, if_found);
+        const __mmask16 leq = _mm512_cmple_epi32_mask(up, tab_i_j_minus_1);
+        _mm512_storeu_si512(curr + j * STRIPE_LANES, _mm512_mask_add_epi32(up, leq, up, one));
+    }
+}
+
+// EFFECTS: returns true if kernel gives the same rows as the scalar kernel on a small test input
+static bool stripe_kernel_matches_scalar(stripe_kernel_t kernel) {
+    // test query, and a different char and row index in every lane
+    const std::string query = "packmyboxwithfivedozenliquorjugsandthensome";
+    const std::string targets = "thequickbrownfoxjumpsoverthelazydog";
+    const int m = query.size();
+    std::vector<int> A(LowercaseAlphabet::SIZE * (m+1));
+    compute_j_minus_k<LowercaseAlphabet>(query, A.data());
+    std::vector<int> prev((m+1) * STRIPE_LANES), expected((m+1) * STRIPE_LANES), actual((m+1) * STRIPE_LANES);
+    for (int j = 0; j <= m; ++j)
+        for (int l = 0; l < STRIPE_LANES; ++l)
+            prev[j * STRIPE_LANES + l] = j;
+    ptrdiff_t A_offset[STRIPE_LANES];
+    int row[STRIPE_LANES];
+    for (int i = 1; i <= (int)targets.size(); ++i) {
+        for (int l = 0; l < STRIPE_LANES; ++l) {
+            A_offset[l] = LowercaseAlphabet::to_idx(targets[(i - 1 + l) % targets.size()]) * (m+1);
+            row[l] = i + l;
+            expected[l] = actual[l] = row[l];
+        }
+        stripe_kernel_scalar(A.data(), prev.data(), expected.data(), A_offset, row, m);
+        kernel(A.data(), prev.data(), actual.data(), A_offset, row, m);
+        if (expected != actual)
+            return false;
+        prev = expected;
+    }
+    return true;
+}
+
+// EFFECTS: returns whether the vector stripe kernels can index memo A of size symbols and the rows
+//          of a query of m chars with 32-bit gather indices
+static bool stripe_kernel_fits_int(const int size, const int m) {
+    return (size_t)MAX(size, STRIPE_LANES) * (m+1) <= (size_t)INT32_MAX;
+}
+
+// EFFECTS: returns the widest stripe kernel supported by the CPU that passes the check
+static stripe_kernel_t select_stripe_kernel(const char *&kernel_name) {
+    return select_kernel<stripe_kernel_t>(stripe_kernel_avx512, stripe_kernel_avx2, stripe_kernel_scalar,
+                                          stripe_kernel_matches_scalar, "stripe", kernel_name);
+}
+
+// MODIFIES: lengths
+// EFFECTS: computes the length of SCS of query and every target into lengths (same order as targets)
+template <typename Alphabet, typename Seq>
+void scs_one_vs_many(const Seq &query, const std::vector<Seq> &targets, std::vector<int> &lengths) {
+    const int m = query.size();
+    const int num_targets = targets.size();
+    lengths.assign(num_targets, 0);
+    const char *kernel_name = "scalar";
+    const stripe_kernel_t stripe_kernel = stripe_kernel_fits_int(Alphabet::SIZE, m) ? select_stripe_kernel(kernel_name)
+                                                                                    : stripe_kernel_scalar;
+    printf("Stripe kernel: %s (%d lanes)\n", kernel_name, STRIPE_LANES);
+    // memo A of the query, built once and shared by all lanes of all threads
+    std::vector<int> A((size_t)Alphabet::SIZE * (m+1));
+    compute_j_minus_k<Alphabet>(query, A.data());
+    // next target that has not been given to a lane yet
+    int next_target = 0;
+#pragma omp parallel
+{
+    // 2 rows of every lane, interleaved
+    std::vector<int> prev_rows((size_t)(m+1) * STRIPE_LANES), curr_rows((size_t)(m+1) * STRIPE_LANES);
+    int *prev = prev_rows.data();
+    int *curr = curr_rows.data();
+    // state of each lane: which target, current row index, and offset into A of the current char
+    int target[STRIPE_LANES], row[STRIPE_LANES];
+    ptrdiff_t A_offset[STRIPE_LANES];
+    for (int l = 0; l < STRIPE_LANES; ++l) {
+        target[l] = -1;
+        // makes the lane look finished, so it gets filled right away
+        row[l] = 1;
+        A_offset[l] = 0;
+    }
+    int num_active = STRIPE_LANES;
+    while (num_active > 0) {
+        // record finished lanes and refill them
+        for (int l = 0; l < STRIPE_LANES; ++l) {
+            while (target[l] != -2 && (target[l] == -1 || row[l] > (int)targets[target[l]].size())) {
+                if (target[l] >= 0)
+                    lengths[target[l]] = prev[(size_t)m * STRIPE_LANES + l];
+                int t;
+#pragma omp atomic capture
+                t = next_target++;
+                if (t >= num_targets) {
+                    // no targets left, the lane computes dummy rows from now on
+                    target[l] = -2;
+                    row[l] = 1;
+                    A_offset[l] = 0;
+                    --num_active;
+                    break;
+                }
+                // base case (row 0) of the new target
+                target[l] = t;
+                row[l] = 1;
+                for (int j = 0; j <= m; ++j)
+                    prev[(size_t)j * STRIPE_LANES + l] = j;
+            }
+            if (target[l] >= 0)
+                A_offset[l] = (ptrdiff_t)symbol_idx<Alphabet>(targets[target[l]], row[l]-1) * (m+1);
+        }
+        if (num_active == 0)
+            break;
+        // base case (col 0)
+        for (int l = 0; l < STRIPE_LANES; ++l)
+            curr[l] = row[l];
+        // one row of every lane
+        stripe_kernel(A.data(), prev, curr, A_offset, row, m);
+        std::swap(prev, curr);
+        for (int l = 0; l < STRIPE_LANES; ++l)
+            ++row[l];
+    }
+}
+}
+
+/* One-vs-many with a prefix trie of the queries
+scs_one_vs_many computes every row of every target, but when many queries X are compared against one
+reference Y, queries often share prefixes (e.g. reads from the same region, or variants of one
+sequence), and row i of tab only depends on Y and the first i chars of X. So the queries are inserted
+into a prefix trie, and the trie is walked depth-first: each trie node (i.e. each distinct prefix)
+costs exactly one row of the row-wise independent recurrence, computed from the row of its parent,
+and a query ending at a node gets its length from col m of the row of that node.
+Memo A only depends on Y, so it is built once for all queries (or mapped from a reference index
+file, see scs_index.h).
+
+Rows are kept on a stack (one buffer per thread, sized upfront): along a chain of nodes with only one
+child, rows are computed back and forth between 2 buffers, and only a node with several children
+keeps its row on the stack until all of its children are done. So the memory is
+(branching nodes on the deepest path + 2) rows per thread, not one row per char of the query.
+
+Threads: if Y is long (at least TRIE_PARALLEL_COLS cols), the trie is walked once and all threads
+work on each row. Otherwise the top of the trie is split into subtrees (at least
+TRIE_ITEMS_PER_THREAD per thread, dynamically scheduled), and each thread first recomputes the
+rows from the root down to the top of a subtree (a few rows), then walks the subtree on its own.
+*/
+
+// reference with at least this many cols uses all threads for each row
+#define TRIE_PARALLEL_COLS (1 << 14)
+// subtrees per thread when the trie is split between threads
+#define TRIE_ITEMS_PER_THREAD 8
+// the trie is not split deeper than this
+#define TRIE_MAX_SPLIT_DEPTH 16
+
+// prefix trie of the queries, node 0 is the root (empty prefix), parents come before their children
+struct QueryTrie {
+    std::vector<int> first_child, next_sibling, parent, symbol, depth;
+    // queries ending at each node, as a list through next_query
+    std::vector<int> first_query, next_query;
+    // rows a walk needs at most, i.e. branching nodes on a path + 2
+    int max_rows = 2;
+
+    // EFFECTS: returns the index of a new node below parent_node for symbol c
+    int add_node(const int parent_node, const int c) {
+        const int node = first_child.size();
+        first_child.push_back(-1);
+        next_sibling.push_back(parent_node >= 0 ? first_child[parent_node] : -1);
+        parent.push_back(parent_node);
+        symbol.push_back(c);
+        depth.push_back(parent_node >= 0 ? depth[parent_node] + 1 : 0);
+        first_query.push_back(-1);
+        if (parent_node >= 0)
+            first_child[parent_node] = node;
+        return node;
+    }
+
+    // EFFECTS: returns whether node has more than one child
+    bool branches(const int node) const {
+        return first_child[node] >= 0 && next_sibling[first_child[node]] >= 0;
+    }
+
+    template <typename Alphabet, typename Seq>
+    void build(const std::vector<Seq> &queries) {
+        add_node(-1, -1);
+        next_query.assign(queries.size(), -1);
+        for (size_t q = 0; q < queries.size(); ++q) {
+            int node = 0;
+            for (size_t i = 0; i < queries[q].size(); ++i) {
+                const int c = symbol_idx<Alphabet>(queries[q], i);
+                int child = first_child[node];
+                while (child >= 0 && symbol[child] != c)
+                    child = next_sibling[child];
+                node = (child >= 0) ? child : add_node(node, c);
+            }
+            next_query[q] = first_query[node];
+            first_query[node] = q;
+        }
+        // branching nodes above each node
+        std::vector<int> branching(first_child.size(), 0);
+        for (size_t node = 1; node < first_child.size(); ++node) {
+            branching[node] = branching[parent[node]] + (branches(parent[node]) ? 1 : 0);
+            max_rows = MAX(max_rows, branching[node] + 2);
+        }
+    }
+};
+
+// REQUIRES: prev holds the row of depth i-1, A_c is the row of memo A for the char of depth i
+// MODIFIES: curr
+// EFFECTS: computes the row of depth i into curr, with all threads if parallel
+template <typename Index>
+static inline void trie_row(const Index *A_c, const int *prev, int *curr, const int i, const int m, const bool parallel) {
+    curr[0] = i;
+    if (parallel) {
+#pragma omp parallel for schedule(static)
+        for (int j = 1; j <= m; ++j)
+            curr[j] = rowwise_independent_cell(A_c, prev, i, j);
+    }
+    else {
+        for (int j = 1; j <= m; ++j)
+            curr[j] = rowwise_independent_cell(A_c, prev, i, j);
+    }
+}
+
+// REQUIRES: row holds the row of node, spare and stack[slot...] are free rows
+// MODIFIES: lengths, row, spare, stack, num_rows
+// EFFECTS: computes the length of SCS of every query in the subtree of node
+template <typename Index>
+static void trie_walk(const QueryTrie &trie, const Index *A, const size_t stride, int node, int *row, int *spare,
+                      int **stack, const int slot, const int m, const bool parallel,
+                      std::vector<int> &lengths, long long &num_rows) {
+    while (true) {
+        for (int q = trie.first_query[node]; q >= 0; q = trie.next_query[q])
+            lengths[q] = row[m];
+        const int child = trie.first_child[node];
+        if (child < 0)
+            return;
+        if (!trie.branches(node)) {
+            // only child, its row replaces the row of node
+            trie_row(&A[trie.symbol[child] * stride], row, spare, trie.depth[child], m, parallel);
+            ++num_rows;
+            std::swap(row, spare);
+            node = child;
+            continue;
+        }
+        // several children, the row of node stays until all of them are done
+        for (int c = child; c >= 0; c = trie.next_sibling[c]) {
+            int *child_row = stack[slot];
+            trie_row(&A[trie.symbol[c] * stride], row, child_row, trie.depth[c], m, parallel);
+            ++num_rows;
+            trie_walk(trie, A, stride, c, child_row, spare, stack, slot + 1, m, parallel, lengths, num_rows);
+        }
+        return;
+    }
+}
+
+// REQUIRES: A is memo A of a reference of m chars, A[c][j] = A[c * stride + j]
+// MODIFIES: lengths
+// EFFECTS: computes the length of SCS of every query and the reference into lengths (same order as
+//          queries), returns the number of rows computed
+template <typename Alphabet, typename Index, typename Seq>
+long long scs_one_vs_many_trie(const Index *A, const size_t stride, const int m, const std::vector<Seq> &queries,
+                               std::vector<int> &lengths, int &num_nodes) {
+    lengths.assign(queries.size(), 0);
+    // Step 2: prefix trie of the queries
+    QueryTrie trie;
+    trie.build<Alphabet>(queries);
+    num_nodes = trie.first_child.size();
+    long long num_rows = 0;
+    if (m >= TRIE_PARALLEL_COLS) {
+        // Step 3a: one walk, all threads work on each row
+        std::vector<int> rows((size_t)trie.max_rows * (m+1));
+        std::vector<int *> stack(trie.max_rows);
+        for (int r = 0; r < trie.max_rows; ++r)
+            stack[r] = &rows[(size_t)r * (m+1)];
+        for (int j = 0; j <= m; ++j)
+            stack[0][j] = j;
+        trie_walk(trie, A, stride, 0, stack[0], stack[1], stack.data(), 2, m, true, lengths, num_rows);
+        return num_rows;
+    }
+    // Step 3b: split the top of the trie into subtrees, expanding one level at a time. Nodes that are
+    // expanded still need their own queries, so they are kept as items that do not walk down.
+    const int num_threads = omp_get_max_threads();
+    std::vector<std::pair<int, bool>> items;
+    std::vector<int> level = {0};
+    for (int d = 0; d < TRIE_MAX_SPLIT_DEPTH && (int)(items.size() + level.size()) < TRIE_ITEMS_PER_THREAD * num_threads; ++d) {
+        std::vector<int> next_level;
+        for (const int node : level) {
+            if (trie.first_child[node] < 0) {
+                items.emplace_back(node, false);
+                continue;
+            }
+            if (trie.first_query[node] >= 0)
+                items.emplace_back(node, false);
+            for (int c = trie.first_child[node]; c >= 0; c = trie.next_sibling[c])
+                next_level.push_back(c);
+        }
+        if (next_level.empty()) {
+            level.clear();
+            break;
+        }
+        level.swap(next_level);
+    }
+    for (const int node : level)
+        items.emplace_back(node, true);
+    const int num_items = items.size();
+#pragma omp parallel reduction(+:num_rows)
+{
+    // row stack of this thread, the path from the root down to the top of a subtree uses the first 2
+    std::vector<int> rows((size_t)trie.max_rows * (m+1));
+    std::vector<int *> stack(trie.max_rows);
+    for (int r = 0; r < trie.max_rows; ++r)
+        stack[r] = &rows[(size_t)r * (m+1)];
+    std::vector<int> path;
+#pragma omp for schedule(dynamic)
+    for (int t = 0; t < num_items; ++t) {
+        const int top = items[t].first;
+        // rows from the root down to top, back and forth between 2 rows
+        path.clear();
+        for (int node = top; node > 0; node = trie.parent[node])
+            path.push_back(node);
+        int *row = stack[0];
+        int *spare = stack[1];
+        for (int j = 0; j <= m; ++j)
+            row[j] = j;
+        for (int p = path.size() - 1; p >= 0; --p) {
+            trie_row(&A[trie.symbol[path[p]] * stride], row, spare, trie.depth[path[p]], m, false);
+            ++num_rows;
+            std::swap(row, spare);
+        }
+        if (items[t].second)
+            trie_walk(trie, A, stride, top, row, spare, stack.data(), 2, m, false, lengths, num_rows);
+        else {
+            for (int q = trie.first_query[top]; q >= 0; q = trie.next_query[q])
+                lengths[q] = row[m];
+        }
+    }
+}
+    return num_rows;
+}
+
+// MODIFIES: lengths
+// EFFECTS: same as above, Step 1: memo A of the reference, built once for all queries
+template <typename Alphabet, typename Seq>
+long long scs_one_vs_many_trie(const Seq &reference, const std::vector<Seq> &queries, std::vector<int> &lengths, int &num_nodes) {
+    const int m = reference.size();
+    std::vector<int> A((size_t)Alphabet::SIZE * (m+1));
+    compute_j_minus_k<Alphabet>(reference, A.data());
+    return scs_one_vs_many_trie<Alphabet>(A.data(), m+1, m, queries, lengths, num_nodes);
+}
+
+// EFFECTS: returns true if s is a subsequence of scs
+inline bool is_subsequence(std::string_view s, std::string_view scs) {
+    size_t idx = 0;
+    for (size_t i = 0; i < scs.size() && idx < s.size(); ++i) {
+        if (scs[i] == s[idx])
+            ++idx;
+    }
+    return idx == s.size();
+}
+
+#endif
@@ -0,0 +1,148 @@
+#ifndef SCS_ALPHABET_H
+#define SCS_ALPHABET_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+Alphabet policies for the engines.
+Each alphabet C[0,...,SIZE-1] provides
+- SIZE: number of symbols, i.e. number of rows in memo A
+- BITS: number of bits used for each symbol in a PackedString
+- symbol(idx): the symbol (char) for an index
+- to_idx(symbol): 0-based index of the symbol, through a constexpr lookup table
+- valid(s): whether every char in s is in the alphabet
+The engines are templated on the alphabet, so e.g. DNA only needs 4 rows in memo A instead of 26.
+*/
+
+// EFFECTS: returns the smallest number of bits (1, 2, 4 or 8) that can hold size different symbols,
+//          only powers of 2 so that a symbol never spans 2 words in a PackedString
+constexpr int bits_per_symbol(const int size) {
+    return size <= 2 ? 1 : size <= 4 ? 2 : size <= 16 ? 4 : 8;
+}
+
+// EFFECTS: returns the lookup table from symbol (as unsigned char) to index, -1 if not in the alphabet
+constexpr std::array<int16_t, 256> make_symbol_map(const char *symbols, const int size) {
+    std::array<int16_t, 256> map{};
+    for (int c = 0; c < 256; ++c)
+        map[c] = -1;
+    for (int idx = 0; idx < size; ++idx)
+        map[(unsigned char)symbols[idx]] = idx;
+    return map;
+}
+
+// CRTP base, Derived provides SIZE and SYMBOLS
+template <typename Derived>
+struct TextAlphabet {
+    static constexpr char symbol(const int idx) {
+        return Derived::SYMBOLS[idx];
+    }
+    static constexpr int to_idx(const char letter) {
+        return MAP[(unsigned char)letter];
+    }
+    static bool valid(std::string_view s) {
+        for (const char letter : s) {
+            if (to_idx(letter) < 0)
+                return false;
+        }
+        return true;
+    }
+    static constexpr std::array<int16_t, 256> MAP = make_symbol_map(Derived::SYMBOLS, Derived::SIZE);
+};
+
+// [a-z] lower case, what the inputs in input/ use
+struct LowercaseAlphabet : TextAlphabet<LowercaseAlphabet> {
+    static constexpr const char *NAME = "lowercase";
+    static constexpr int SIZE = 26;
+    static constexpr char SYMBOLS[SIZE + 1] = "abcdefghijklmnopqrstuvwxyz";
+    static constexpr int BITS = bits_per_symbol(SIZE);
+};
+
+// nucleotides
+struct DnaAlphabet : TextAlphabet<DnaAlphabet> {
+    static constexpr const char *NAME = "dna";
+    static constexpr int SIZE = 4;
+    static constexpr char SYMBOLS[SIZE + 1] = "ACGT";
+    static constexpr int BITS = bits_per_symbol(SIZE);
+};
+
+// the 20 standard amino acids
+struct ProteinAlphabet : TextAlphabet<ProteinAlphabet> {
+    static constexpr const char *NAME = "protein";
+    static constexpr int SIZE = 20;
+    static constexpr char SYMBOLS[SIZE + 1] = "ACDEFGHIKLMNPQRSTVWY";
+    static constexpr int BITS = bits_per_symbol(SIZE);
+};
+
+// arbitrary bytes, the index is simply the byte itself
+struct ByteAlphabet {
+    static constexpr const char *NAME = "byte";
+    static constexpr int SIZE = 256;
+    static constexpr int BITS = bits_per_symbol(SIZE);
+    static constexpr char symbol(const int idx) {
+        return char(idx);
+    }
+    static constexpr int to_idx(const char letter) {
+        return (unsigned char)letter;
+    }
+    static bool valid(std::string_view) {
+        return true;
+    }
+};
+
+/*
+String where each symbol is stored as its index in Alphabet using Alphabet::BITS bits,
+e.g. 2 bits for DNA, so 32 symbols fit in each 64-bit word.
+*/
+template <typename Alphabet>
+class PackedString {
+public:
+    static constexpr int SYMBOLS_PER_WORD = 64 / Alphabet::BITS;
+
+    // REQUIRES: Alphabet::valid(s)
+    explicit PackedString(std::string_view s)
+        : length(s.size()), words((s.size() + SYMBOLS_PER_WORD - 1) / SYMBOLS_PER_WORD, 0) {
+        for (size_t i = 0; i < s.size(); ++i)
+            words[i / SYMBOLS_PER_WORD] |= uint64_t(Alphabet::to_idx(s[i])) << ((i % SYMBOLS_PER_WORD) * Alphabet::BITS);
+    }
+
+    size_t size() const {
+        return length;
+    }
+
+    // EFFECTS: returns the index in Alphabet of the ith symbol
+    int idx(const size_t i) const {
+        return (words[i / SYMBOLS_PER_WORD] >> ((i % SYMBOLS_PER_WORD) * Alphabet::BITS)) & MASK;
+    }
+
+    // EFFECTS: returns the number of bytes used to store the symbols
+    size_t bytes() const {
+        return words.size() * sizeof(uint64_t);
+    }
+
+private:
+    static constexpr uint64_t MASK = (uint64_t(1) << Alphabet::BITS) - 1;
+    size_t length;
+    std::vector<uint64_t> words;
+};
+
+// EFFECTS: returns the index in Alphabet of the ith symbol of s, for both plain and packed strings
+template <typename Alphabet>
+inline int symbol_idx(const std::string &s, const size_t i) {
+    return Alphabet::to_idx(s[i]);
+}
+
+template <typename Alphabet>
+inline int symbol_idx(std::string_view s, const size_t i) {
+    return Alphabet::to_idx(s[i]);
+}
+
+template <typename Alphabet>
+inline int symbol_idx(const PackedString<Alphabet> &s, const size_t i) {
+    return s.idx(i);
+}
+
+#endif
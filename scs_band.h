@@ -0,0 +1,69 @@
+#ifndef SCS_BAND_H
+#define SCS_BAND_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+/*
+Band of diagonals for the banded engines (serial_scs banded and the banded engine of parallel_omp_scs).
+A path through tab from [0][0] to [n][m] with D diagonal moves (matches) has n-D vertical and m-D
+horizontal moves, so its length is n+m-D and it has 2 * length - (n+m) non-diagonal moves.
+A path through a cell on diagonal k = j - i needs at least |k| non-diagonal moves to get there and
+|(m-n) - k| more to get to [n][m]. So a path that leaves the band of diagonals
+    min(0, m-n) - d <= k <= max(0, m-n) + d
+has length at least (n + m + |m-n| + 2(d+1)) / 2.
+Thus if the shortest path inside the band (what the banded engines compute, cells outside the band
+are never used) is at most that long, no path outside the band can be shorter, and it is the length
+of the SCS. Otherwise d is doubled and the band computed again (Ukkonen), which is O((n+m) * d) cells
+per pass, i.e. fast when the strings are similar and the optimal path stays close to the diagonal.
+For the question "is the SCS at most L long?", d can be picked right away: every path of length at
+most L stays within d = (2L - (n+m) - |m-n|) / 2 of the diagonals, and the rows can stop as soon as
+no cell of a row can still lead to a path of length at most L.
+*/
+
+// band width of the first pass
+#define BAND_INITIAL_WIDTH 32
+// cells outside the band, large enough to never be the MIN, small enough to add to without overflow
+#define BAND_INFINITY (INT32_MAX / 2)
+
+struct ScsBand {
+    int n, m;
+    // band width, i.e. number of diagonals on either side of the diagonals between [0][0] and [n][m]
+    long long d;
+
+    // EFFECTS: returns the lowest and highest diagonal (j - i) in the band
+    long long lowest_diagonal() const {
+        return std::min(0, m - n) - d;
+    }
+    long long highest_diagonal() const {
+        return std::max(0, m - n) + d;
+    }
+
+    // EFFECTS: returns the first and last col of row i in the band, always contains [0][0] and [n][m]
+    int lo(const int i) const {
+        return std::max<long long>(0, i + lowest_diagonal());
+    }
+    int hi(const int i) const {
+        return std::min<long long>(m, i + highest_diagonal());
+    }
+
+    // EFFECTS: returns whether the band contains every cell
+    bool covers_all() const {
+        return lowest_diagonal() <= -n && highest_diagonal() >= m;
+    }
+
+    // EFFECTS: returns whether length, the shortest path inside the band, is the length of SCS
+    bool is_optimal(const long long length) const {
+        return covers_all() || 2 * length <= (long long)n + m + std::abs(m - n) + 2 * (d + 1);
+    }
+
+    // EFFECTS: returns the band width that contains every path of length at most max_length,
+    //          negative if there is none, i.e. max_length < max(n, m)
+    static long long width_for(const int n, const int m, const long long max_length) {
+        const long long twice = 2 * max_length - n - m - std::abs(m - n);
+        return twice < 0 ? -1 : twice / 2;
+    }
+};
+
+#endif
@@ -0,0 +1,127 @@
+#ifndef SCS_CHECKPOINT_H
+#define SCS_CHECKPOINT_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "scs_hash.h"
+
+/*
+Checkpoint file of the checkpointed engine (see scs_rowwise_independent_checkpointed), so a run that
+is killed (e.g. by the time limit of a job) can resume instead of starting over.
+The file is memory-mapped (shared), and holds every interval-th row of tab:
+    header                  one page, see CheckpointHeader
+    row 0, row interval, row 2*interval, ...    m+1 ints each
+Rows written into a shared mapping are in the page cache, so they survive the process being killed.
+Each row is also synced to disk before the header says it is there (last_row), so a checkpoint is
+never half written, even if the machine goes down.
+The header identifies the inputs (lengths, alphabet, hash of both strings) and the interval, a file
+that does not match is started over.
+*/
+
+#define CHECKPOINT_MAGIC "SCSCKPT"
+#define CHECKPOINT_VERSION 1
+#define CHECKPOINT_HEADER_BYTES 4096
+
+struct CheckpointHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t alphabet_size;
+    uint64_t n, m;
+    uint64_t interval;
+    uint64_t input_hash;
+    // last row that is checkpointed (a multiple of interval)
+    uint64_t last_row;
+};
+
+// checkpoint rows in a memory-mapped file
+class CheckpointFile {
+public:
+    CheckpointFile() = default;
+    CheckpointFile(const CheckpointFile &) = delete;
+    CheckpointFile &operator=(const CheckpointFile &) = delete;
+    ~CheckpointFile() {
+        if (addr != nullptr)
+            munmap(addr, length);
+    }
+
+    // MODIFIES: this
+    // EFFECTS: opens (or creates) the checkpoint file at path for the given problem, starting it over
+    //          if it is for a different one, returns false if it cannot be created or mapped
+    bool open(const std::string &path, const CheckpointHeader &expected) {
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0)
+            return false;
+        const uint64_t num_rows = expected.n / expected.interval + 1;
+        length = CHECKPOINT_HEADER_BYTES + num_rows * (expected.m + 1) * sizeof(int);
+        struct stat info;
+        if (fstat(fd, &info) != 0 || ((size_t)info.st_size != length && ftruncate(fd, length) != 0)) {
+            close(fd);
+            return false;
+        }
+        void *mapped = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        // the mapping stays valid after the file is closed
+        close(fd);
+        if (mapped == MAP_FAILED) {
+            addr = nullptr;
+            return false;
+        }
+        addr = (char *)mapped;
+        CheckpointHeader *header = (CheckpointHeader *)addr;
+        CheckpointHeader start = expected;
+        if (memcmp(header->magic, CHECKPOINT_MAGIC, sizeof(header->magic)) == 0 && header->version == CHECKPOINT_VERSION &&
+            header->alphabet_size == expected.alphabet_size && header->n == expected.n && header->m == expected.m &&
+            header->interval == expected.interval && header->input_hash == expected.input_hash &&
+            header->last_row <= expected.n)
+            return true;
+        // different problem (or a new file): start over, nothing is checkpointed yet
+        memcpy(start.magic, CHECKPOINT_MAGIC, sizeof(start.magic));
+        start.version = CHECKPOINT_VERSION;
+        start.last_row = UINT64_MAX;
+        memcpy(header, &start, sizeof(start));
+        msync(addr, CHECKPOINT_HEADER_BYTES, MS_SYNC);
+        return true;
+    }
+
+    // EFFECTS: returns whether any row is checkpointed
+    bool has_rows() const {
+        return ((const CheckpointHeader *)addr)->last_row != UINT64_MAX;
+    }
+
+    // REQUIRES: has_rows()
+    // EFFECTS: returns the last checkpointed row
+    int last_row() const {
+        return ((const CheckpointHeader *)addr)->last_row;
+    }
+
+    // REQUIRES: i is a multiple of the interval
+    // EFFECTS: returns the checkpoint of row i
+    int *row(const int i) {
+        const CheckpointHeader *header = (const CheckpointHeader *)addr;
+        return (int *)(addr + CHECKPOINT_HEADER_BYTES) + (size_t)(i / header->interval) * (header->m + 1);
+    }
+
+    // REQUIRES: row(i) has been written
+    // MODIFIES: this
+    // EFFECTS: makes row i the last checkpointed row, after it is on disk
+    void commit(const int i) {
+        const CheckpointHeader *header = (const CheckpointHeader *)addr;
+        // msync needs a page-aligned start
+        const uintptr_t begin = (uintptr_t)row(i) / CHECKPOINT_HEADER_BYTES * CHECKPOINT_HEADER_BYTES;
+        const uintptr_t end = (uintptr_t)(row(i) + header->m + 1);
+        msync((void *)begin, end - begin, MS_SYNC);
+        ((CheckpointHeader *)addr)->last_row = i;
+        msync(addr, CHECKPOINT_HEADER_BYTES, MS_SYNC);
+    }
+
+private:
+    char *addr = nullptr;
+    size_t length = 0;
+};
+
+#endif
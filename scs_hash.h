@@ -0,0 +1,37 @@
+#ifndef SCS_HASH_H
+#define SCS_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include "scs_alphabet.h"
+
+/*
+FNV-1a hashes of the file formats: the checkpoint file identifies its inputs by the hash of both
+strings, the reference index identifies its reference by the hash of it and checks the header and
+the table by the hash of their bytes. Not cryptographic, only to tell a file that does not match.
+*/
+
+#define FNV_OFFSET_BASIS 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+// EFFECTS: returns the FNV-1a hash of the symbols (indices in Alphabet) of s, continuing from hash
+template <typename Alphabet, typename Seq>
+uint64_t sequence_hash(const Seq &s, uint64_t hash = FNV_OFFSET_BASIS) {
+    for (size_t i = 0; i < s.size(); ++i) {
+        hash ^= (uint64_t)symbol_idx<Alphabet>(s, i);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// EFFECTS: returns the FNV-1a hash of bytes, continuing from hash
+inline uint64_t bytes_hash(const void *bytes, const size_t size, uint64_t hash = FNV_OFFSET_BASIS) {
+    const unsigned char *data = (const unsigned char *)bytes;
+    for (size_t b = 0; b < size; ++b) {
+        hash ^= data[b];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+#endif
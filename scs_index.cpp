@@ -0,0 +1,87 @@
+#include <omp.h>
+#include <string>
+#include "scs_index.h"
+#include "scs_input.h"
+
+/*
+Builds and checks reference index files (see scs_index.h).
+    ./scs_index build <input file> <index file> <alphabet>    index of the first string of the input
+    ./scs_index verify <index file>                          checks the header and the whole table
+The trie mode of parallel_omp_batch_scs then maps the index instead of building memo A, e.g.
+    SCS_REFERENCE_INDEX=ref.idx ./parallel_omp_batch_scs reads.txt dna trie
+*/
+
+// EFFECTS: builds the index of Y with the alphabet of the given name, returns false if the alphabet
+//          is unknown, Y has chars outside of it or the file cannot be written
+bool build_index(const std::string &alphabet, std::string_view Y, const std::string &index_file) {
+    if (alphabet == LowercaseAlphabet::NAME && LowercaseAlphabet::valid(Y))
+        return write_reference_index<LowercaseAlphabet>(index_file, Y);
+    if (alphabet == DnaAlphabet::NAME && DnaAlphabet::valid(Y))
+        return write_reference_index<DnaAlphabet>(index_file, Y);
+    if (alphabet == ProteinAlphabet::NAME && ProteinAlphabet::valid(Y))
+        return write_reference_index<ProteinAlphabet>(index_file, Y);
+    if (alphabet == ByteAlphabet::NAME)
+        return write_reference_index<ByteAlphabet>(index_file, Y);
+    printf("Error: Unknown alphabet %s or reference has chars outside of it\n", alphabet.c_str());
+    return false;
+}
+
+// EFFECTS: prints the header of index
+void print_index_info(const ReferenceIndex &index) {
+    const ScsIndexHeader &header = index.header();
+    printf("Index Version: %u, Alphabet Size: %u, Reference Length: %llu\n",
+           header.version, header.alphabet_size, (unsigned long long)header.m);
+    printf("Bits per entry: %u, Stride: %llu\n", 8 * header.entry_bytes, (unsigned long long)header.stride);
+}
+
+int main(int argc, char** argv) {
+    const std::string command = (argc >= 2) ? argv[1] : "";
+    if (command == "build" && argc == 5) {
+        const std::string input_file = argv[2];
+        const std::string index_file = argv[3];
+        printf("Input: %s\n", input_file.c_str());
+        ScsInput input;
+        if (!load_input(input_file, input))
+            return 1;
+        print_load_info(input);
+        if (input.records.empty()) {
+            printf("Error: Input file has no strings: %s\n", input_file.c_str());
+            return 1;
+        }
+        double start, end;
+        // record start time
+        start = omp_get_wtime();
+        if (!build_index(argv[4], input.records[0], index_file)) {
+            printf("Error: Could not write index file: %s\n", index_file.c_str());
+            return 1;
+        }
+        // record end time
+        end = omp_get_wtime();
+        printf("Execution Time (ms) %f\n", (end - start) * 1000.0);
+        ReferenceIndex index;
+        std::string error;
+        if (!index.open(index_file, error)) {
+            printf("Error: Index file %s: %s\n", index_file.c_str(), error.c_str());
+            return 1;
+        }
+        print_index_info(index);
+        return 0;
+    }
+    if (command == "verify" && argc == 3) {
+        const std::string index_file = argv[2];
+        ReferenceIndex index;
+        std::string error;
+        if (!index.open(index_file, error)) {
+            printf("Error: Index file %s: %s\n", index_file.c_str(), error.c_str());
+            return 1;
+        }
+        print_index_info(index);
+        const bool valid = index.verify();
+        printf("Checksum: %s\n", valid ? "ok" : "mismatch");
+        return valid ? 0 : 1;
+    }
+    printf("Error: Invalid arguments provided\n");
+    printf("Usage: ./scs_index build <input file> <index file> <alphabet = lowercase | dna | protein | byte>\n");
+    printf("       ./scs_index verify <index file>\n");
+    return 1;
+}
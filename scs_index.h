@@ -0,0 +1,208 @@
+#ifndef SCS_INDEX_H
+#define SCS_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "scs_alphabet.h"
+#include "scs_hash.h"
+
+/*
+Reference index file: memo A of a reference string Y (see compute_j_minus_k), built once by scs_index
+and memory-mapped read-only by every later run (the trie mode of parallel_omp_batch_scs), so the
+precompute is gone from startup and all processes on the machine share one copy in the page cache.
+    header          one page, see ScsIndexHeader
+    A[0][0..m]      stride entries each (padded to a cache line), A[c][j] = A[c * stride + j]
+    A[1][0..m]
+    ...
+The entries are positions in Y (0 to m), so they are stored in 16 bits if m fits, 32 bits otherwise,
+which halves the size (and the memory traffic of the row kernel reading it) for references of up to
+65535 chars. Every row starts on a cache line, like the rows of the arena of libscs.
+
+The header is checked on every open (magic, version, alphabet, its own checksum, the length and hash
+of the reference), which is O(m) for the hash. The checksum of the table itself is O(|C| * m), i.e.
+about as much as building it, so it is only checked by scs_index verify (e.g. after copying the file).
+The file is written next to its final path and renamed, so a reader never sees half a file.
+*/
+
+#define INDEX_MAGIC "SCSINDX"
+#define INDEX_VERSION 1
+#define INDEX_HEADER_BYTES 4096
+#define INDEX_ALIGN 64
+
+struct ScsIndexHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t alphabet_size;
+    // bytes per entry, 2 or 4
+    uint32_t entry_bytes;
+    uint32_t reserved;
+    uint64_t m;
+    // entries per row of A
+    uint64_t stride;
+    // sequence_hash of the reference
+    uint64_t reference_hash;
+    // FNV-1a of the table
+    uint64_t data_checksum;
+    // FNV-1a of all the fields above
+    uint64_t header_checksum;
+};
+
+// EFFECTS: returns the checksum of the fields of header before header_checksum
+inline uint64_t index_header_checksum(const ScsIndexHeader &header) {
+    return bytes_hash(&header, offsetof(ScsIndexHeader, header_checksum));
+}
+
+// EFFECTS: returns the bytes per entry of A for a reference of m chars
+inline uint32_t index_entry_bytes(const uint64_t m) {
+    return (m <= UINT16_MAX) ? 2 : 4;
+}
+
+// REQUIRES: A has Alphabet::SIZE * stride entries
+// MODIFIES: A
+// EFFECTS: same as compute_j_minus_k, with entries of type Index
+template <typename Alphabet, typename Index, typename Seq>
+void build_index_table(const Seq &Y, Index *A, const size_t stride) {
+    const size_t m = Y.size();
+#pragma omp parallel for
+    for (int c = 0; c < Alphabet::SIZE; ++c) {
+        Index *A_c = &A[(size_t)c * stride];
+        A_c[0] = 0;
+        for (size_t j = 1; j <= m; ++j)
+            A_c[j] = (symbol_idx<Alphabet>(Y, j-1) == c) ? (Index)j : A_c[j-1];
+        // padding
+        for (size_t j = m + 1; j < stride; ++j)
+            A_c[j] = 0;
+    }
+}
+
+// EFFECTS: builds the index of reference Y and writes it to path, returns false if it cannot be written
+template <typename Alphabet, typename Seq>
+bool write_reference_index(const std::string &path, const Seq &Y) {
+    const size_t m = Y.size();
+    ScsIndexHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, INDEX_MAGIC, sizeof(header.magic));
+    header.version = INDEX_VERSION;
+    header.alphabet_size = Alphabet::SIZE;
+    header.entry_bytes = index_entry_bytes(m);
+    header.m = m;
+    // round each row up to a cache line
+    const size_t per_line = INDEX_ALIGN / header.entry_bytes;
+    header.stride = (m + 1 + per_line - 1) / per_line * per_line;
+    header.reference_hash = sequence_hash<Alphabet>(Y);
+    const size_t table_bytes = (size_t)Alphabet::SIZE * header.stride * header.entry_bytes;
+    std::vector<char> table(table_bytes);
+    if (header.entry_bytes == 2)
+        build_index_table<Alphabet>(Y, (uint16_t *)table.data(), header.stride);
+    else
+        build_index_table<Alphabet>(Y, (uint32_t *)table.data(), header.stride);
+    header.data_checksum = bytes_hash(table.data(), table_bytes);
+    header.header_checksum = index_header_checksum(header);
+    // header page, then the table
+    std::vector<char> page(INDEX_HEADER_BYTES, 0);
+    memcpy(page.data(), &header, sizeof(header));
+    const std::string temp_path = path + ".tmp";
+    FILE *file = fopen(temp_path.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+    const bool written = fwrite(page.data(), 1, page.size(), file) == page.size() &&
+                         fwrite(table.data(), 1, table_bytes, file) == table_bytes;
+    if (fclose(file) != 0 || !written || rename(temp_path.c_str(), path.c_str()) != 0) {
+        remove(temp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+// index file mapped read-only
+class ReferenceIndex {
+public:
+    ReferenceIndex() = default;
+    ReferenceIndex(const ReferenceIndex &) = delete;
+    ReferenceIndex &operator=(const ReferenceIndex &) = delete;
+    ~ReferenceIndex() {
+        if (addr != nullptr)
+            munmap(addr, length);
+    }
+
+    // MODIFIES: this
+    // EFFECTS: maps the index file at path, returns false (with the reason in error) if it cannot be
+    //          mapped or its header is not valid
+    bool open(const std::string &path, std::string &error) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            error = "cannot open file";
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || (size_t)info.st_size < INDEX_HEADER_BYTES) {
+            close(fd);
+            error = "file is too small";
+            return false;
+        }
+        length = info.st_size;
+        void *mapped = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        // the mapping stays valid after the file is closed
+        close(fd);
+        if (mapped == MAP_FAILED) {
+            error = "cannot map file";
+            return false;
+        }
+        addr = (char *)mapped;
+        const ScsIndexHeader &h = header();
+        if (memcmp(h.magic, INDEX_MAGIC, sizeof(h.magic)) != 0)
+            error = "not an index file";
+        else if (h.version != INDEX_VERSION)
+            error = "unsupported version " + std::to_string(h.version);
+        else if (h.header_checksum != index_header_checksum(h))
+            error = "header checksum mismatch";
+        else if ((h.entry_bytes != 2 && h.entry_bytes != 4) || h.stride < h.m + 1 ||
+                 length != INDEX_HEADER_BYTES + h.alphabet_size * h.stride * h.entry_bytes)
+            error = "wrong file size";
+        else
+            return true;
+        munmap(addr, length);
+        addr = nullptr;
+        return false;
+    }
+
+    // REQUIRES: open succeeded
+    // EFFECTS: returns whether this is the index of Y in Alphabet
+    template <typename Alphabet, typename Seq>
+    bool matches(const Seq &Y) const {
+        const ScsIndexHeader &h = header();
+        return h.alphabet_size == Alphabet::SIZE && h.m == Y.size() && h.reference_hash == sequence_hash<Alphabet>(Y);
+    }
+
+    // REQUIRES: open succeeded
+    // EFFECTS: returns whether the checksum of the table matches, reads the whole file
+    bool verify() const {
+        const ScsIndexHeader &h = header();
+        return bytes_hash(addr + INDEX_HEADER_BYTES, length - INDEX_HEADER_BYTES) == h.data_checksum;
+    }
+
+    const ScsIndexHeader &header() const {
+        return *(const ScsIndexHeader *)addr;
+    }
+
+    // REQUIRES: open succeeded, sizeof(Index) == header().entry_bytes
+    // EFFECTS: returns memo A, A[c][j] = A[c * header().stride + j]
+    template <typename Index>
+    const Index *table() const {
+        return (const Index *)(addr + INDEX_HEADER_BYTES);
+    }
+
+private:
+    char *addr = nullptr;
+    size_t length = 0;
+};
+
+#endif
@@ -0,0 +1,284 @@
+#ifndef SCS_INPUT_H
+#define SCS_INPUT_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+Input layer shared by all the programs.
+Instead of copying the whole file through std::ifstream + std::getline into std::string, the
+file is mapped into memory (mmap) and the strings (records) are handed out as std::string_view
+into the mapping, so the OS pages the file in as the engines read it and nothing is copied.
+3 formats are detected from the start of the file:
+1. Text: one string per line, what the inputs in input/ use
+2. FASTA: each record starts with a ">name" line, followed by the sequence on one or more lines.
+   A sequence on a single line is viewed in place, one split over several lines has to be joined
+   into a copy (owned by the ScsInput).
+3. Packed binary, for large genomic inputs:
+       "SCSPACK\0"             8 byte magic
+       uint32 bits             bits per symbol, 2 (ACGT) or 8 (raw bytes)
+       uint32 num_records
+       then for each record:
+       uint64 length           number of symbols
+       symbols                 packed from the lowest bit of each byte, padded to a multiple of 8 bytes
+   8 bit records are viewed in place. 2 bit records (4x smaller on disk) are unpacked into ACGT text
+   once at load time. The 2 bit layout is the same as PackedString<DnaAlphabet> (on little-endian).
+*/
+
+#define PACKED_MAGIC "SCSPACK"
+#define PACKED_MAGIC_BYTES 8
+
+// read-only mapping of a whole file
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    ~MappedFile() {
+        if (addr != nullptr)
+            munmap((void *)addr, length);
+    }
+
+    // MODIFIES: this
+    // EFFECTS: maps the file at path, returns false if it cannot be opened or mapped
+    bool open(const std::string &path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            return false;
+        }
+        length = info.st_size;
+        // an empty file cannot be mapped, but it is still a valid (empty) input
+        if (length > 0) {
+            void *mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                close(fd);
+                length = 0;
+                return false;
+            }
+            addr = (const char *)mapped;
+            // the records are read front to back
+            madvise(mapped, length, MADV_SEQUENTIAL);
+        }
+        // the mapping stays valid after the file is closed
+        close(fd);
+        return true;
+    }
+
+    const char *data() const {
+        return addr;
+    }
+
+    size_t size() const {
+        return length;
+    }
+
+private:
+    const char *addr = nullptr;
+    size_t length = 0;
+};
+
+enum class InputFormat { TEXT, FASTA, PACKED };
+
+// EFFECTS: returns the name of the format, for printing
+inline const char *format_name(const InputFormat format) {
+    return format == InputFormat::TEXT ? "text" : format == InputFormat::FASTA ? "fasta" : "packed";
+}
+
+// all the records of one input file, valid for as long as the ScsInput is alive
+struct ScsInput {
+    InputFormat format = InputFormat::TEXT;
+    std::vector<std::string_view> records;
+    // FASTA headers (without the '>'), empty for the other formats
+    std::vector<std::string_view> names;
+    double load_ms = 0;
+    MappedFile file;
+    // records that are not stored contiguously in the file (a deque never moves its elements)
+    std::deque<std::string> owned;
+};
+
+// EFFECTS: returns the line starting at pos without the line break (and '\r'), moves pos past it
+inline std::string_view next_line(std::string_view text, size_t &pos) {
+    size_t end = text.find('\n', pos);
+    if (end == std::string_view::npos)
+        end = text.size();
+    std::string_view line = text.substr(pos, end - pos);
+    pos = end + 1;
+    if (!line.empty() && line.back() == '\r')
+        line.remove_suffix(1);
+    return line;
+}
+
+// MODIFIES: input
+// EFFECTS: one record per line (same as std::getline, i.e. no record after the last line break)
+inline void parse_text(std::string_view text, ScsInput &input) {
+    size_t pos = 0;
+    while (pos < text.size())
+        input.records.push_back(next_line(text, pos));
+}
+
+// MODIFIES: input
+// EFFECTS: one record per ">name" line, returns false if there is a sequence before the first one
+inline bool parse_fasta(std::string_view text, ScsInput &input) {
+    size_t pos = 0;
+    while (pos < text.size()) {
+        std::string_view line = next_line(text, pos);
+        if (line.empty())
+            continue;
+        if (line[0] != '>')
+            return false;
+        input.names.push_back(line.substr(1));
+        // sequence lines up to the next header
+        std::string_view first;
+        std::string *joined = nullptr;
+        while (pos < text.size() && text[pos] != '>') {
+            line = next_line(text, pos);
+            if (line.empty())
+                continue;
+            if (joined != nullptr)
+                joined->append(line);
+            else if (first.empty())
+                first = line;
+            else {
+                // opt: only copy sequences that are split over several lines
+                input.owned.emplace_back(first);
+                joined = &input.owned.back();
+                joined->append(line);
+            }
+        }
+        input.records.push_back(joined != nullptr ? std::string_view(*joined) : first);
+    }
+    return true;
+}
+
+// MODIFIES: input
+// EFFECTS: reads the packed binary format, returns false if the file is cut short or malformed
+inline bool parse_packed(std::string_view data, ScsInput &input) {
+    const size_t header_bytes = PACKED_MAGIC_BYTES + 2 * sizeof(uint32_t);
+    if (data.size() < header_bytes)
+        return false;
+    uint32_t bits, num_records;
+    memcpy(&bits, data.data() + PACKED_MAGIC_BYTES, sizeof(uint32_t));
+    memcpy(&num_records, data.data() + PACKED_MAGIC_BYTES + sizeof(uint32_t), sizeof(uint32_t));
+    if (bits != 2 && bits != 8)
+        return false;
+    size_t pos = header_bytes;
+    for (uint32_t r = 0; r < num_records; ++r) {
+        uint64_t length;
+        if (data.size() - pos < sizeof(uint64_t))
+            return false;
+        memcpy(&length, data.data() + pos, sizeof(uint64_t));
+        pos += sizeof(uint64_t);
+        // (checked before computing the bytes, which could overflow)
+        if (length > (data.size() - pos) * 8 / bits)
+            return false;
+        // bytes of symbols, rounded up to whole 64-bit words
+        const uint64_t symbol_bytes = (length * bits + 63) / 64 * 8;
+        if (data.size() - pos < symbol_bytes)
+            return false;
+        const unsigned char *symbols = (const unsigned char *)data.data() + pos;
+        if (bits == 8)
+            input.records.push_back(data.substr(pos, length));
+        else {
+            input.owned.emplace_back(length, ' ');
+            std::string &record = input.owned.back();
+            for (uint64_t i = 0; i < length; ++i)
+                record[i] = "ACGT"[(symbols[i / 4] >> ((i % 4) * 2)) & 3];
+            input.records.push_back(record);
+        }
+        pos += symbol_bytes;
+    }
+    return true;
+}
+
+// MODIFIES: input
+// EFFECTS: maps the file at path and splits it into records (format detected from its start),
+//          prints an error and returns false if it cannot be read
+inline bool load_input(const std::string &path, ScsInput &input) {
+    std::chrono::time_point<std::chrono::steady_clock> start, end;
+    start = std::chrono::steady_clock::now();
+    if (!input.file.open(path)) {
+        printf("Error opening file: %s\n", path.c_str());
+        return false;
+    }
+    const std::string_view data(input.file.data(), input.file.size());
+    bool ok = true;
+    if (data.size() >= PACKED_MAGIC_BYTES && memcmp(data.data(), PACKED_MAGIC, PACKED_MAGIC_BYTES) == 0) {
+        input.format = InputFormat::PACKED;
+        ok = parse_packed(data, input);
+    }
+    else if (!data.empty() && data[0] == '>') {
+        input.format = InputFormat::FASTA;
+        ok = parse_fasta(data, input);
+    }
+    else {
+        input.format = InputFormat::TEXT;
+        parse_text(data, input);
+    }
+    if (!ok) {
+        printf("Error: Malformed %s input file: %s\n", format_name(input.format), path.c_str());
+        return false;
+    }
+    end = std::chrono::steady_clock::now();
+    input.load_ms = std::chrono::duration<double, std::milli>(end - start).count();
+    return true;
+}
+
+// EFFECTS: prints the format, number of records and time taken to load them
+inline void print_load_info(const ScsInput &input) {
+    printf("Input Format: %s, Number of strings %zu\n", format_name(input.format), input.records.size());
+    printf("Load Time (ms) %f\n", input.load_ms);
+}
+
+// MODIFIES: input
+// EFFECTS: loads the input of the programs that take 2 strings X, Y (the first 2 records),
+//          prints an error and returns false if it cannot be read or has fewer than 2 records
+inline bool load_pair_input(const std::string &path, ScsInput &input) {
+    if (!load_input(path, input))
+        return false;
+    print_load_info(input);
+    if (input.records.size() < 2) {
+        printf("Error: Input file has fewer than 2 strings: %s\n", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+// REQUIRES: bits is 2 or 8, if bits is 2 then all records only contain ACGT
+// MODIFIES: out
+// EFFECTS: writes records in the packed binary format
+inline void write_packed(std::ostream &out, const std::vector<std::string> &records, const uint32_t bits) {
+    const uint32_t num_records = records.size();
+    out.write(PACKED_MAGIC, PACKED_MAGIC_BYTES);
+    out.write((const char *)&bits, sizeof(uint32_t));
+    out.write((const char *)&num_records, sizeof(uint32_t));
+    std::vector<unsigned char> symbols;
+    for (const std::string &record : records) {
+        const uint64_t length = record.size();
+        out.write((const char *)&length, sizeof(uint64_t));
+        symbols.assign((length * bits + 63) / 64 * 8, 0);
+        for (uint64_t i = 0; i < length; ++i) {
+            if (bits == 8)
+                symbols[i] = record[i];
+            else
+                symbols[i / 4] |= (strchr("ACGT", record[i]) - "ACGT") << ((i % 4) * 2);
+        }
+        out.write((const char *)symbols.data(), symbols.size());
+    }
+}
+
+#endif
@@ -0,0 +1,174 @@
+#ifndef SCS_NUMA_H
+#define SCS_NUMA_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+#include <dirent.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/*
+NUMA placement for the engines where each thread owns a block of cols (see the pipelined engine).
+Linux places a page on the NUMA node of the thread that first touches it, so
+1. buffers are allocated with mmap, which does not touch the pages (std::vector would zero them all
+   from the thread that allocates, i.e. put everything on one node)
+2. each thread is pinned to one CPU, threads in order of the NUMA node of their CPU, so neighbouring
+   blocks (which read each other's cols the most) are on the same node, and unpinned again (back to
+   the affinity mask it had before) when the engine finishes
+3. each thread first touches its own block of cols of every row, so its block is on its own node
+The placement is then checked with move_pages (which only queries when no target node is given),
+reporting how many pages of each thread's block are on its own node (local) or not (remote).
+This is where the pages are, not local/remote traffic: a thread reading its neighbour's cols at
+the block border still makes remote accesses, which the page counts do not show. Counting the
+traffic would need the node-local/remote memory events of the PMU (e.g. node-loads/node-load-misses
+opened like the counters of scs_perf.h), which are not available in every VM, so the page placement
+is reported instead, as the check that first touch put each block where it should be.
+Only raw syscalls and /sys are used, so there is no dependency on libnuma.
+*/
+
+#define NUMA_PAGE_BYTES 4096
+
+// array of T backed by pages that are not touched until they are first written
+template <typename T>
+class NumaArray {
+public:
+    explicit NumaArray(const size_t size) : length(size) {
+        bytes = std::max<size_t>(size * sizeof(T), 1);
+        void *mapped = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapped == MAP_FAILED) {
+            printf("Error: Could not allocate %zu bytes\n", bytes);
+            exit(1);
+        }
+        addr = (T *)mapped;
+    }
+    NumaArray(const NumaArray &) = delete;
+    NumaArray &operator=(const NumaArray &) = delete;
+    ~NumaArray() {
+        munmap(addr, bytes);
+    }
+
+    T *data() {
+        return addr;
+    }
+    const T *data() const {
+        return addr;
+    }
+    T &operator[](const size_t i) {
+        return addr[i];
+    }
+    const T &operator[](const size_t i) const {
+        return addr[i];
+    }
+    size_t size() const {
+        return length;
+    }
+
+private:
+    T *addr;
+    size_t length;
+    size_t bytes;
+};
+
+// EFFECTS: returns the NUMA node of cpu (from /sys), 0 if it cannot be found, e.g. no NUMA support
+inline int numa_node_of(const int cpu) {
+    const std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    DIR *dir = opendir(path.c_str());
+    if (dir == nullptr)
+        return 0;
+    int node = 0;
+    while (struct dirent *entry = readdir(dir)) {
+        if (strncmp(entry->d_name, "node", 4) == 0 && entry->d_name[4] >= '0' && entry->d_name[4] <= '9') {
+            node = atoi(entry->d_name + 4);
+            break;
+        }
+    }
+    closedir(dir);
+    return node;
+}
+
+// EFFECTS: returns the CPUs the process may run on (as (node, cpu) pairs) sorted by node, then CPU
+inline std::vector<std::pair<int, int>> numa_sorted_cpus() {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    std::vector<std::pair<int, int>> cpus;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &allowed))
+                cpus.emplace_back(numa_node_of(cpu), cpu);
+        }
+    }
+    std::sort(cpus.begin(), cpus.end());
+    return cpus;
+}
+
+// REQUIRES: cpus is not empty
+// MODIFIES: saved
+// EFFECTS: pins the calling thread to the CPU for thread tid (more threads than CPUs wrap around),
+//          saves the affinity mask it had before into saved, returns the CPU
+inline int numa_pin_thread(const std::vector<std::pair<int, int>> &cpus, const int tid, cpu_set_t &saved) {
+    const int cpu = cpus[tid % cpus.size()].second;
+    CPU_ZERO(&saved);
+    sched_getaffinity(0, sizeof(saved), &saved);
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    sched_setaffinity(0, sizeof(set), &set);
+    return cpu;
+}
+
+// REQUIRES: saved was filled in by numa_pin_thread
+// EFFECTS: sets the affinity mask of the calling thread back to saved
+inline void numa_unpin_thread(const cpu_set_t &saved) {
+    sched_setaffinity(0, sizeof(saved), &saved);
+}
+
+// MODIFIES: local, remote
+// EFFECTS: adds the number of pages in [ptr, ptr + bytes) that are (not) on node,
+//          pages that are not mapped yet are not counted
+inline void numa_count_pages(const void *ptr, const size_t bytes, const int node, long long &local, long long &remote) {
+    if (bytes == 0)
+        return;
+    const uintptr_t first = (uintptr_t)ptr / NUMA_PAGE_BYTES * NUMA_PAGE_BYTES;
+    const uintptr_t last = ((uintptr_t)ptr + bytes - 1) / NUMA_PAGE_BYTES * NUMA_PAGE_BYTES;
+    std::vector<void *> pages;
+    for (uintptr_t page = first; page <= last; page += NUMA_PAGE_BYTES)
+        pages.push_back((void *)page);
+    std::vector<int> status(pages.size(), -1);
+    // no target nodes given: only returns the node of each page
+    if (syscall(SYS_move_pages, 0, pages.size(), pages.data(), nullptr, status.data(), 0) != 0)
+        return;
+    for (int page_node : status) {
+        if (page_node == node)
+            ++local;
+        else if (page_node >= 0)
+            ++remote;
+    }
+}
+
+// where the threads ran and where the pages of their blocks ended up (placement, not traffic)
+struct NumaReport {
+    std::vector<int> cpu_of_thread;
+    std::vector<int> node_of_thread;
+    long long local_pages = 0;
+    long long remote_pages = 0;
+
+    // EFFECTS: prints the report
+    void print() const {
+        int num_nodes = 0;
+        for (int node : node_of_thread)
+            num_nodes = std::max(num_nodes, node + 1);
+        printf("NUMA Nodes Used %d, Local Pages %lld, Remote Pages %lld\n", num_nodes, local_pages, remote_pages);
+        for (size_t t = 0; t < cpu_of_thread.size(); ++t)
+            printf("Thread %zu CPU %d Node %d\n", t, cpu_of_thread[t], node_of_thread[t]);
+    }
+};
+
+#endif
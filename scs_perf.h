@@ -0,0 +1,192 @@
+#ifndef SCS_PERF_H
+#define SCS_PERF_H
+
+#include <omp.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/*
+Opt-in instrumentation (perf_event_open) for finding out whether an engine is bound by memory,
+synchronization or compute.
+- Hardware counters (cycles, instructions, LLC misses) are opened on every thread of the process
+  (user space only, which is all perf_event_paranoid <= 2 allows), and summed at the start and end
+  of each phase, so each phase gets the counts of all threads while it ran.
+- There is no portable counter for DRAM traffic (the memory controller events are uncore and vendor
+  specific), so the DRAM bandwidth is estimated as LLC misses * cache line size / time.
+- If the counters cannot be opened (e.g. no PMU in a VM, or perf_event_paranoid > 2), the phases
+  still get their time, and the counters are reported as unavailable.
+The engine also measures the time each thread waits in the barriers (see
+scs_rowwise_independent_instrumented).
+*/
+
+#define PERF_NUM_COUNTERS 3
+#define PERF_CACHE_LINE_BYTES 64
+
+static const char *PERF_COUNTER_NAMES[PERF_NUM_COUNTERS] = {"cycles", "instructions", "llc_misses"};
+
+// counters opened on every thread of the process
+class PerfCounters {
+public:
+    PerfCounters() = default;
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+    ~PerfCounters() {
+        for (int fd : fds)
+            close(fd);
+    }
+
+    // REQUIRES: all the threads that will run the engine have already been created
+    // MODIFIES: this
+    // EFFECTS: opens the counters on every thread of the process, returns false if any cannot be opened
+    bool open() {
+        static const uint64_t configs[PERF_NUM_COUNTERS] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES};
+        DIR *tasks = opendir("/proc/self/task");
+        if (tasks == nullptr)
+            return false;
+        bool ok = true;
+        while (struct dirent *task = readdir(tasks)) {
+            if (task->d_name[0] == '.')
+                continue;
+            const pid_t tid = atoi(task->d_name);
+            for (int c = 0; c < PERF_NUM_COUNTERS && ok; ++c) {
+                struct perf_event_attr attr;
+                memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = configs[c];
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                int fd = syscall(SYS_perf_event_open, &attr, tid, -1, -1, 0);
+                if (fd < 0)
+                    ok = false;
+                else
+                    fds.push_back(fd);
+            }
+        }
+        closedir(tasks);
+        return ok && !fds.empty();
+    }
+
+    // EFFECTS: returns the sum of each counter over all threads
+    void read_all(long long values[PERF_NUM_COUNTERS]) const {
+        for (int c = 0; c < PERF_NUM_COUNTERS; ++c)
+            values[c] = 0;
+        for (size_t f = 0; f < fds.size(); ++f) {
+            long long value;
+            if (read(fds[f], &value, sizeof(value)) == sizeof(value))
+                values[f % PERF_NUM_COUNTERS] += value;
+        }
+    }
+
+private:
+    // PERF_NUM_COUNTERS fds per thread
+    std::vector<int> fds;
+};
+
+// time and counters of one phase
+struct PerfPhase {
+    std::string name;
+    double ms;
+    long long counters[PERF_NUM_COUNTERS];
+};
+
+// all the measurements of one run of an engine
+class PerfReport {
+public:
+    // EFFECTS: opens the counters on the threads of the current OpenMP team size
+    void open(const int max_threads) {
+        // make sure the thread pool exists before listing the threads
+#pragma omp parallel num_threads(max_threads)
+        { }
+        counters_available = counters.open();
+        for_wait_ms.assign(max_threads, 0);
+        single_wait_ms.assign(max_threads, 0);
+    }
+
+    // EFFECTS: starts a phase
+    void begin_phase(const char *name) {
+        phase.name = name;
+        if (counters_available)
+            counters.read_all(phase.counters);
+        phase_start = omp_get_wtime();
+    }
+
+    // EFFECTS: ends the phase started last
+    void end_phase() {
+        phase.ms = (omp_get_wtime() - phase_start) * 1000.0;
+        long long end_counters[PERF_NUM_COUNTERS] = {0};
+        if (counters_available)
+            counters.read_all(end_counters);
+        for (int c = 0; c < PERF_NUM_COUNTERS; ++c)
+            phase.counters[c] = counters_available ? end_counters[c] - phase.counters[c] : -1;
+        phases.push_back(phase);
+    }
+
+    // EFFECTS: prints the report
+    void print() const {
+        printf("Hardware Counters: %s\n", counters_available ? "available" : "unavailable");
+        for (const PerfPhase &p : phases) {
+            printf("Phase %s Time (ms) %f", p.name.c_str(), p.ms);
+            if (counters_available) {
+                printf(", Cycles %lld, Instructions %lld, IPC %.2f, LLC Misses %lld, Estimated DRAM Bandwidth (GB/s) %.2f",
+                       p.counters[0], p.counters[1], p.counters[0] > 0 ? double(p.counters[1]) / p.counters[0] : 0.0,
+                       p.counters[2], dram_gb_per_s(p));
+            }
+            printf("\n");
+        }
+        for (size_t t = 0; t < for_wait_ms.size(); ++t)
+            printf("Thread %zu Barrier Wait (ms) omp for %f, omp single %f\n", t, for_wait_ms[t], single_wait_ms[t]);
+    }
+
+    // EFFECTS: writes the report as JSON to path, returns false if the file cannot be opened
+    bool write_json(const char *path) const {
+        FILE *out = fopen(path, "w");
+        if (out == nullptr)
+            return false;
+        fprintf(out, "{\n  \"counters_available\": %s,\n  \"phases\": [\n", counters_available ? "true" : "false");
+        for (size_t i = 0; i < phases.size(); ++i) {
+            const PerfPhase &p = phases[i];
+            fprintf(out, "    {\"name\": \"%s\", \"ms\": %f", p.name.c_str(), p.ms);
+            for (int c = 0; c < PERF_NUM_COUNTERS; ++c)
+                fprintf(out, ", \"%s\": %lld", PERF_COUNTER_NAMES[c], p.counters[c]);
+            fprintf(out, ", \"estimated_dram_gb_per_s\": %f}%s\n", counters_available ? dram_gb_per_s(p) : -1.0,
+                    i + 1 < phases.size() ? "," : "");
+        }
+        fprintf(out, "  ],\n  \"threads\": [\n");
+        for (size_t t = 0; t < for_wait_ms.size(); ++t) {
+            fprintf(out, "    {\"thread\": %zu, \"omp_for_barrier_ms\": %f, \"omp_single_barrier_ms\": %f}%s\n", t,
+                    for_wait_ms[t], single_wait_ms[t], t + 1 < for_wait_ms.size() ? "," : "");
+        }
+        fprintf(out, "  ]\n}\n");
+        fclose(out);
+        return true;
+    }
+
+    // time each thread waited in the barrier after the omp for / omp single of every row,
+    // each thread only writes its own entry
+    std::vector<double> for_wait_ms;
+    std::vector<double> single_wait_ms;
+
+private:
+    // EFFECTS: returns the DRAM bandwidth of the phase, estimated from its LLC misses
+    static double dram_gb_per_s(const PerfPhase &p) {
+        return p.ms > 0 ? double(p.counters[2]) * PERF_CACHE_LINE_BYTES / (p.ms * 1e6) : 0.0;
+    }
+
+    PerfCounters counters;
+    bool counters_available = false;
+    PerfPhase phase;
+    double phase_start = 0;
+    std::vector<PerfPhase> phases;
+};
+
+#endif
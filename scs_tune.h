@@ -0,0 +1,290 @@
+#ifndef SCS_TUNE_H
+#define SCS_TUNE_H
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "parallel_omp_scs.h"
+
+/*
+Auto-tuning dispatcher (the auto engine of parallel_omp_scs and ScsContext::tune).
+Which engine and how many threads is fastest depends on the machine as much as on the problem:
+small problems are dominated by the barrier per row (or per anti-diagonal), so fewer threads or the
+serial kernel win, large ones by memory bandwidth, and the bit-parallel kernel wins whenever it fits
+the alphabet well. Instead of guessing, the candidates are timed once on this machine:
+    serial          row-wise independent recurrence, 1 thread (scs_rowwise_independent_serial)
+    rowwise         row-wise independent recurrence, 2 rows (scs_rowwise_independent_linear)
+    anti_diagonal   Anti-diagonal Algorithm, 3 diagonals (scs_anti_diagonal_rolling)
+    bit_parallel    bit-vector LCS, 1 thread (scs_bit_parallel)
+with team sizes of 1, 2, 4, ... up to the largest team size (and the largest itself), on random
+strings of the alphabet. The shape matters as much as the number of cells (bit_parallel does one
+64-bit word of m per step of n, the anti-diagonals are at most n long, the rows of the row-wise
+engines m long), so the candidates are timed on a grid of shapes n x m, with n and m each from
+TUNE_MIN_SIZE to TUNE_MAX_SIZE chars (times TUNE_SIZE_STEP each time), skipping the shapes of more
+than TUNE_MAX_CELLS cells, i.e. from squares to a ratio of 256 between the lengths.
+The fastest (best of TUNE_REPEATS runs) of each shape is saved in a profile, a text file with a line
+    <alphabet> <max threads> <n> <m> <engine> <threads> <ms>
+per shape, so calibration only runs once per machine and alphabet. The largest team size is the
+number of cores for the auto engine, and the number of threads of the context for ScsContext::tune,
+so a context never uses a team size that was not timed. A problem of n x m uses the choice of the
+closest shape in (log n, log m), so e.g. a long X against a short Y gets the choice of the most
+skewed shape, not of a square with the same number of cells. Shapes beyond the grid (e.g. a
+ratio of more than 256) use the choice of the closest one at its edge.
+*/
+
+#define TUNE_MIN_SIZE 64
+#define TUNE_MAX_SIZE 16384
+#define TUNE_SIZE_STEP 4
+// about 8192 x 8192
+#define TUNE_MAX_CELLS (1LL << 26)
+#define TUNE_REPEATS 3
+#define TUNE_PROFILE_HEADER "# scs tune profile v2: <alphabet> <max threads> <n> <m> <engine> <threads> <ms>"
+
+enum TuneEngine {
+    TUNE_SERIAL,
+    TUNE_ROWWISE,
+    TUNE_ANTI_DIAGONAL,
+    TUNE_BIT_PARALLEL,
+    TUNE_NUM_ENGINES
+};
+
+static const char *const TUNE_ENGINE_NAMES[TUNE_NUM_ENGINES] = {"serial", "rowwise", "anti_diagonal", "bit_parallel"};
+
+// size of a calibrated problem, X has n chars and Y m chars
+struct TuneShape {
+    int n;
+    int m;
+};
+
+// engine and team size picked for one shape
+struct TuneChoice {
+    int engine;
+    int threads;
+    double ms;
+};
+
+// EFFECTS: returns the number of ints of buffer run_tuned needs for engine on n x m
+template <typename Alphabet>
+size_t tune_buffer_ints(const int engine, const size_t n, const size_t m) {
+    if (engine == TUNE_SERIAL || engine == TUNE_ROWWISE)
+        return Alphabet::SIZE * (m+1) + 2 * (m+1);
+    if (engine == TUNE_ANTI_DIAGONAL)
+        return 3 * (n+1);
+    // bit_parallel: match masks and 1 row, in 64-bit words
+    const size_t num_words = (m + WORD_BITS - 1) / WORD_BITS;
+    return 2 * (Alphabet::SIZE * num_words + num_words);
+}
+
+// REQUIRES: buffer has tune_buffer_ints(choice.engine, n, m) ints (8-byte aligned)
+// MODIFIES: buffer
+// EFFECTS: returns the length of SCS with the engine and team size of choice, the number of threads
+//          of later parallel regions stays the same
+template <typename Alphabet, typename Seq>
+int run_tuned(const TuneChoice &choice, const Seq &s1, const Seq &s2, int *buffer) {
+    const size_t m = s2.size();
+    if (choice.engine == TUNE_SERIAL || choice.engine == TUNE_ROWWISE) {
+        int *A = buffer;
+        int *prev = A + Alphabet::SIZE * (m+1);
+        int *curr = prev + (m+1);
+        if (choice.engine == TUNE_SERIAL)
+            return scs_rowwise_independent_serial<Alphabet>(s1, s2, A, prev, curr);
+        return scs_rowwise_independent_linear<Alphabet>(s1, s2, A, prev, curr, choice.threads);
+    }
+    if (choice.engine == TUNE_ANTI_DIAGONAL)
+        return scs_anti_diagonal_rolling<Alphabet>(s1, s2, buffer, choice.threads);
+    const size_t num_words = (m + WORD_BITS - 1) / WORD_BITS;
+    uint64_t *M = (uint64_t *)buffer;
+    uint64_t *V = M + Alphabet::SIZE * num_words;
+    std::fill(M, M + Alphabet::SIZE * num_words, 0);
+    std::fill(V, V + num_words, ~uint64_t(0));
+    return scs_bit_parallel<Alphabet>(s1, s2, M, V);
+}
+
+template <typename Alphabet>
+class ScsTuner {
+public:
+    // EFFECTS: creates a tuner for team sizes of at most max_threads (all cores by default)
+    explicit ScsTuner(const int max_threads = omp_get_num_procs()) : max_threads(max_threads) {}
+
+    // MODIFIES: this
+    // EFFECTS: loads the choices for Alphabet and max_threads from the profile at path,
+    //          returns false if it has none (or not one for every shape)
+    bool load(const std::string &path) {
+        std::ifstream file(path);
+        if (!file)
+            return false;
+        std::vector<TuneChoice> loaded(shapes().size(), TuneChoice{-1, 0, 0.0});
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream fields(line);
+            std::string alphabet, engine;
+            int threads_bound, n, m;
+            TuneChoice choice;
+            if (line.empty() || line[0] == '#' || !(fields >> alphabet >> threads_bound >> n >> m >> engine >> choice.threads >> choice.ms))
+                continue;
+            const int k = shape_index(n, m);
+            if (alphabet != Alphabet::NAME || threads_bound != max_threads || k < 0)
+                continue;
+            choice.engine = engine_index(engine);
+            if (choice.engine < 0 || choice.threads <= 0 || choice.threads > max_threads)
+                continue;
+            loaded[k] = choice;
+        }
+        for (const TuneChoice &choice : loaded)
+            if (choice.engine < 0)
+                return false;
+        choices = loaded;
+        return true;
+    }
+
+    // MODIFIES: this
+    // EFFECTS: times every engine and team size on random strings of every shape, keeps the fastest
+    void calibrate() {
+        std::vector<int> teams;
+        for (int t = 1; t < max_threads; t *= 2)
+            teams.push_back(t);
+        teams.push_back(max_threads);
+        std::mt19937 gen(1);
+        std::uniform_int_distribution<int> symbol(0, Alphabet::SIZE - 1);
+        std::vector<int> buffer;
+        choices.clear();
+        for (const TuneShape &shape : shapes()) {
+            std::string X(shape.n, ' '), Y(shape.m, ' ');
+            for (char &x : X)
+                x = Alphabet::symbol(symbol(gen));
+            for (char &y : Y)
+                y = Alphabet::symbol(symbol(gen));
+            TuneChoice best{-1, 0, 0.0};
+            for (int engine = 0; engine < TUNE_NUM_ENGINES; ++engine) {
+                buffer.resize(MAX(buffer.size(), tune_buffer_ints<Alphabet>(engine, shape.n, shape.m)));
+                for (const int threads : teams) {
+                    // the serial kernels run on 1 thread no matter the team size
+                    if ((engine == TUNE_SERIAL || engine == TUNE_BIT_PARALLEL) && threads > 1)
+                        break;
+                    const TuneChoice candidate{engine, threads, time_best(TuneChoice{engine, threads, 0.0}, X, Y, buffer.data())};
+                    if (best.engine < 0 || candidate.ms < best.ms)
+                        best = candidate;
+                }
+            }
+            choices.push_back(best);
+        }
+    }
+
+    // EFFECTS: writes the choices to the profile at path, keeping the lines of other alphabets and
+    //          largest team sizes, returns false if it cannot be written
+    bool save(const std::string &path) const {
+        std::vector<std::string> kept;
+        std::ifstream in(path);
+        std::string line;
+        while (std::getline(in, line)) {
+            std::istringstream fields(line);
+            std::string alphabet;
+            int threads_bound;
+            if (line.empty() || line[0] == '#')
+                continue;
+            if (fields >> alphabet >> threads_bound && alphabet == Alphabet::NAME && threads_bound == max_threads)
+                continue;
+            kept.push_back(line);
+        }
+        in.close();
+        FILE *out = fopen(path.c_str(), "w");
+        if (out == nullptr)
+            return false;
+        fprintf(out, "%s\n", TUNE_PROFILE_HEADER);
+        for (const std::string &other : kept)
+            fprintf(out, "%s\n", other.c_str());
+        for (size_t k = 0; k < shapes().size(); ++k)
+            fprintf(out, "%s %d %d %d %s %d %f\n", Alphabet::NAME, max_threads, shapes()[k].n, shapes()[k].m,
+                    TUNE_ENGINE_NAMES[choices[k].engine], choices[k].threads, choices[k].ms);
+        return fclose(out) == 0;
+    }
+
+    // MODIFIES: this
+    // EFFECTS: loads the profile at path, or calibrates and saves it if it has no choices for this
+    //          alphabet and largest team size, returns whether it calibrated
+    bool load_or_calibrate(const std::string &path) {
+        if (load(path))
+            return false;
+        calibrate();
+        if (!save(path))
+            printf("Error opening file: %s\n", path.c_str());
+        return true;
+    }
+
+    // REQUIRES: load or calibrate has been called
+    // EFFECTS: returns the choice of the shape closest to n x m in (log n, log m)
+    const TuneChoice &choose(const size_t n, const size_t m) const {
+        const double log_n = std::log2(MAX((double)n, 1.0));
+        const double log_m = std::log2(MAX((double)m, 1.0));
+        size_t best = 0;
+        double best_distance = 0.0;
+        for (size_t k = 0; k < shapes().size(); ++k) {
+            const double d_n = log_n - std::log2((double)shapes()[k].n);
+            const double d_m = log_m - std::log2((double)shapes()[k].m);
+            const double distance = d_n * d_n + d_m * d_m;
+            if (k == 0 || distance < best_distance) {
+                best = k;
+                best_distance = distance;
+            }
+        }
+        return choices[best];
+    }
+
+    // EFFECTS: returns the choice of each shape, in the order of shapes()
+    const std::vector<TuneChoice> &all_choices() const {
+        return choices;
+    }
+
+    // EFFECTS: returns the calibrated shapes, n x m for n and m from TUNE_MIN_SIZE to TUNE_MAX_SIZE
+    //          with at most TUNE_MAX_CELLS cells
+    static const std::vector<TuneShape> &shapes() {
+        static const std::vector<TuneShape> grid = [] {
+            std::vector<TuneShape> all;
+            for (int n = TUNE_MIN_SIZE; n <= TUNE_MAX_SIZE; n *= TUNE_SIZE_STEP)
+                for (int m = TUNE_MIN_SIZE; m <= TUNE_MAX_SIZE; m *= TUNE_SIZE_STEP)
+                    if ((long long)n * m <= TUNE_MAX_CELLS)
+                        all.push_back(TuneShape{n, m});
+            return all;
+        }();
+        return grid;
+    }
+
+private:
+    int max_threads;
+    std::vector<TuneChoice> choices;
+
+    // EFFECTS: returns the index of n x m in shapes(), -1 if it is not one of them
+    static int shape_index(const int n, const int m) {
+        for (size_t k = 0; k < shapes().size(); ++k)
+            if (shapes()[k].n == n && shapes()[k].m == m)
+                return k;
+        return -1;
+    }
+
+    static int engine_index(const std::string &name) {
+        for (int engine = 0; engine < TUNE_NUM_ENGINES; ++engine)
+            if (name == TUNE_ENGINE_NAMES[engine])
+                return engine;
+        return -1;
+    }
+
+    // EFFECTS: returns the fastest of TUNE_REPEATS runs in ms, after a run to warm up the team
+    static double time_best(const TuneChoice &choice, const std::string &X, const std::string &Y, int *buffer) {
+        run_tuned<Alphabet>(choice, X, Y, buffer);
+        double best = 0.0;
+        for (int r = 0; r < TUNE_REPEATS; ++r) {
+            const double start = omp_get_wtime();
+            run_tuned<Alphabet>(choice, X, Y, buffer);
+            const double ms = (omp_get_wtime() - start) * 1000.0;
+            if (r == 0 || ms < best)
+                best = ms;
+        }
+        return best;
+    }
+};
+
+#endif
@@ -2,7 +2,9 @@
 #include <string>
 #include <iostream>
 #include <chrono>
-#include <fstream>
+#include <vector>
+#include "scs_band.h"
+#include "scs_input.h"
 
 /*
 class Solution {
@@ -107,7 +109,7 @@ public:
 };
 */
 
-int SCS(const std::string &s1, const std::string &s2, std::chrono::duration<double, std::milli> &time) {
+int SCS(std::string_view s1, std::string_view s2, std::chrono::duration<double, std::milli> &time) {
     // get length of both strings
     int n = s1.size();
     int m = s2.size();
@@ -151,9 +153,94 @@ int SCS(const std::string &s1, const std::string &s2, std::chrono::duration<doub
     return tab[n][m];
 }
 
+// REQUIRES: max_length < 0 (no limit) or band contains every path of length at most max_length
+// EFFECTS: returns the length of the shortest path inside band (same recurrence as SCS, cells outside
+//          the band are never used), only keeping 2 rows,
+//          BAND_INFINITY if it stopped early bc no path can be at most max_length long
+int SCS_band(std::string_view s1, std::string_view s2, const ScsBand &band, const long long max_length) {
+    const int n = s1.size();
+    const int m = s2.size();
+    // 1 extra col, so the col right of the band of the previous row can always be read
+    std::vector<int> prev_row(m+2), curr_row(m+2);
+    int *prev = prev_row.data();
+    int *curr = curr_row.data();
+    // base case (row 0)
+    for (int j = 0; j <= band.hi(0); ++j)
+        prev[j] = j;
+    prev[band.hi(0) + 1] = BAND_INFINITY;
+    for (int i = 1; i <= n; ++i) {
+        const int lo = band.lo(i);
+        const int hi = band.hi(i);
+        // the col left of the band
+        if (lo > 0)
+            curr[lo-1] = BAND_INFINITY;
+        // lowest length any path through this row can still have
+        long long lowest = BAND_INFINITY;
+        for (int j = lo; j <= hi; ++j) {
+            // base case
+            if (j == 0) {
+                curr[j] = i;
+            }
+            // case 1 (j-1 is in the band of the previous row)
+            else if (s1[i-1] == s2[j-1]) {
+                curr[j] = 1 + prev[j-1];
+            }
+            // case 2
+            else {
+                curr[j] = 1 + std::min(curr[j-1], prev[j]);
+            }
+            lowest = std::min<long long>(lowest, curr[j] + std::max(n - i, m - j));
+        }
+        // the col right of the band
+        curr[hi + 1] = BAND_INFINITY;
+        if (max_length >= 0 && lowest > max_length)
+            return BAND_INFINITY;
+        std::swap(prev, curr);
+    }
+    return prev[m];
+}
+
+// EFFECTS: returns the length of SCS, computing the band of diagonals with doubling width
+//          until it is optimal (see scs_band.h), band is the last band
+int SCS_banded(std::string_view s1, std::string_view s2, ScsBand &band, int &passes, std::chrono::duration<double, std::milli> &time) {
+    std::chrono::time_point<std::chrono::system_clock> start, end;
+    start = std::chrono::high_resolution_clock::now();
+    band = {(int)s1.size(), (int)s2.size(), BAND_INITIAL_WIDTH};
+    int length;
+    passes = 0;
+    while (true) {
+        length = SCS_band(s1, s2, band, -1);
+        ++passes;
+        if (band.is_optimal(length))
+            break;
+        band.d *= 2;
+    }
+    end = std::chrono::high_resolution_clock::now();
+    time = end - start;
+    return length;
+}
+
+// EFFECTS: returns whether the length of SCS is at most max_length, computing only the band of
+//          diagonals such a path can use, and stopping at the first row that rules it out
+bool SCS_at_most(std::string_view s1, std::string_view s2, const long long max_length, std::chrono::duration<double, std::milli> &time) {
+    std::chrono::time_point<std::chrono::system_clock> start, end;
+    start = std::chrono::high_resolution_clock::now();
+    const long long d = ScsBand::width_for(s1.size(), s2.size(), max_length);
+    bool at_most = false;
+    if (d >= 0) {
+        const ScsBand band = {(int)s1.size(), (int)s2.size(), d};
+        at_most = SCS_band(s1, s2, band, max_length) <= max_length;
+    }
+    end = std::chrono::high_resolution_clock::now();
+    time = end - start;
+    return at_most;
+}
+
 int main(int argc, char** argv) {
-    // get input file name from commandline if one is provided
+    // get input file name (and engine, max length) from commandline if one is provided
     std::string input_file;
+    std::string engine = "full";
+    long long max_length = -1;
     if (argc == 1) {
         // default input file name
         input_file = "input/input-2000.txt";
@@ -161,32 +248,44 @@ int main(int argc, char** argv) {
     else if (argc == 2) {
         input_file = argv[1];
     }
+    else if ((argc == 3 || argc == 4) && (std::string(argv[2]) == "full" || std::string(argv[2]) == "banded")) {
+        input_file = argv[1];
+        engine = argv[2];
+        if (argc == 4)
+            max_length = atoll(argv[3]);
+    }
     else {
         printf("Error: Invalid number of arguments provided\n");
-        printf("Usage: ./<program> <input file>\n");
+        printf("Usage: ./<program> <input file> <engine = full(default) | banded> <max length (banded only)>\n");
         return 1;
     }
     printf("Input: %s\n", input_file.c_str());
-    // 2 input strings
-    std::string X = "ozpxennwaelglzwocdybdmpmmcyconwcmlbsaoqcvciidewfiuiljaavcazqnvvbjyvjpmokqwstboa";
-    std::string Y = "iyklqkkdhnvwnrjbxkuyltiaqbllgsipqvaihmlozhnmyypxkjwwegyujjhqepfumhfuvqiuzvixtxxgivcobakllrbriimvrrpmjzgjxqisnfy";
-    // read input string from file
-    std::ifstream fin;
-    fin.open(input_file);
-    // throw error if the file opening fails
-    if (!fin.is_open()) {
-        printf("Error opening file: %s\n", input_file.c_str());
+    // read the 2 input strings from file (views into the mapped file)
+    ScsInput input;
+    if (!load_pair_input(input_file, input))
         return 1;
-    }
-    std::getline(fin, X);
-    std::getline(fin, Y);
-    // printf("Size of X is %d, first char in X is %c\n", X.size(), X[0]);
-    // printf("Size of Y is %d, first char in Y is %c\n", Y.size(), Y[0]);
-    fin.close();
+    const std::string_view X = input.records[0];
+    const std::string_view Y = input.records[1];
     // declare timer
     std::chrono::duration<double, std::milli> elapsed_ms;
+    if (engine == "banded" && max_length >= 0) {
+        // only whether SCS is at most max_length long
+        const bool at_most = SCS_at_most(X, Y, max_length, elapsed_ms);
+        printf("Execution Time (ms) %f\n", elapsed_ms.count());
+        printf("SCS At Most %lld: %s\n", max_length, at_most ? "true" : "false");
+        return 0;
+    }
     // get SCS
-    int length = SCS(X, Y, elapsed_ms);
+    int length;
+    if (engine == "banded") {
+        ScsBand band;
+        int passes;
+        length = SCS_banded(X, Y, band, passes, elapsed_ms);
+        printf("Band Width %lld, Passes %d\n", band.d, passes);
+    }
+    else {
+        length = SCS(X, Y, elapsed_ms);
+    }
     // output
     printf("Execution Time (ms) %f\n", elapsed_ms.count());
     printf("Length of SCS is %d\n", length);